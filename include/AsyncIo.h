@@ -0,0 +1,263 @@
+/**
+ * @file   AsyncIo.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Completion driven file I/O for ThreadPool (io_uring, thread based emulation as fallback)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ASYNCIO_H_
+#define ASYNCIO_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <pthread.h>
+
+//C++11
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+//common_cpp
+#include <ThreadPool.h>
+
+/**
+ * io_uring via raw syscalls (kernel header only, no liburing needed)
+ */
+#if !defined(NO_IO_URING_TP_SUPPORT) && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+		#include <sys/syscall.h>
+		#include <linux/io_uring.h>
+		// IORING_OP_READ/WRITE: kernel headers >= 5.7
+		#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_FEAT_FAST_POLL)
+			#define TP_IO_URING	1
+		#endif
+	#endif
+#endif
+
+//logging macros
+#ifndef AsyncIo_log_debug
+	#define AsyncIo_log_debug(...)
+#endif
+
+#ifndef AsyncIo_log_error
+	#define AsyncIo_log_error(...)
+#endif
+
+/**
+ * default size of submission ring (completion ring: twice), also limit of operations in flight
+ */
+#ifndef TP_ASYNCIO_ENTRIES
+	#define TP_ASYNCIO_ENTRIES	256
+#endif
+
+/**
+ * count of I/O threads of the emulation
+ */
+#ifndef TP_ASYNCIO_EMU_THREADS
+	#define TP_ASYNCIO_EMU_THREADS	2
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Continuation of an asynchronous read/write
+/**
+ * Delegated to the pool when the operation is completed, the result is set before.
+ */
+class AsyncIoFunctor: public Functor {
+public:
+	AsyncIoFunctor():m_io_result(0){};
+	virtual ~AsyncIoFunctor(){};
+
+	/**
+	 * result of operation: transferred bytes or -errno
+	 */
+	int64_t getIoResult(void){return m_io_result;}
+	void setIoResult(int64_t result){m_io_result = result;}
+
+private:
+	int64_t m_io_result;
+};
+
+///Asynchronous file I/O executor
+/**
+ * pread/pwrite like operations are submitted to an io_uring instance. A completion thread waits for
+ * completions, drains the completion ring in batches and delegates the continuation functors to the pool
+ * -> no WorkerThread is blocked by file I/O.
+ * Without io_uring (not compiled in, not permitted by kernel/seccomp) the operations are handled by
+ * TP_ASYNCIO_EMU_THREADS own threads with the same interface.
+ *
+ * Buffers have to stay valid until the continuation is called. The destructor waits for operations in flight.
+ */
+class AsyncIo {
+public:
+	/**
+	 * @param pool		pool for continuations
+	 * @param entries	size of submission ring, limit of operations in flight
+	 * @param emulation	force thread based emulation
+	 */
+	AsyncIo(ThreadPool *pool, uint32_t entries = TP_ASYNCIO_ENTRIES, bool emulation = false);
+
+	/**
+	 * - wait for operations in flight, stop completion/emulation threads
+	 */
+	virtual ~AsyncIo();
+
+	/**
+	 * submit read of len bytes at offset into buffer
+	 * @param continuation	delegated to pool on completion (released by pool)
+	 * @param flush		submit now, else collect until flush() (batch, emulation: always now)
+	 * @return		[success]: NULL
+	 * 			[failure]: continuation (too many operations in flight or ring not submitted, not deleted)
+	 */
+	FunctorInt *read(int fd, void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush = true);
+
+	/**
+	 * submit write of len bytes from buffer at offset
+	 * - see read
+	 */
+	FunctorInt *write(int fd, const void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush = true);
+
+	/**
+	 * submit all collected operations (one system call)
+	 */
+	void flush(void);
+
+	/**
+	 * check if thread based emulation is used
+	 */
+	bool isEmulated(void){return m_emulated;}
+
+	/**
+	 * get count of submitted but not completed operations
+	 */
+	uint32_t getInflightCount(void){return m_inflight.load(std::memory_order_acquire);}
+
+private:
+	///operation of emulation
+	struct IoRequest {
+		bool write;
+		int fd;
+		void *buffer;
+		size_t len;
+		off_t offset;
+		AsyncIoFunctor *continuation;
+	};
+
+	/**
+	 * add operation (ring or emulation queue)
+	 */
+	FunctorInt *submit(bool write, int fd, void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush);
+
+	/**
+	 * delegate completed continuation to pool (waits for free queue space)
+	 */
+	void complete(AsyncIoFunctor *continuation, int64_t result);
+
+#ifdef TP_IO_URING
+	/**
+	 * create ring and map shared memory
+	 * @return false if io_uring is not usable
+	 */
+	bool setupRing(uint32_t entries);
+
+	/**
+	 * unmap shared memory, close ring
+	 */
+	void closeRing(void);
+
+	/**
+	 * submit collected entries
+	 * - m_submit_lock has to be locked by caller
+	 */
+	void flushLocked(void);
+
+	/**
+	 * wait for and drain completions
+	 */
+	void completion_func(void);
+
+	int m_ring_fd;
+	void *p_sq_ptr;
+	size_t m_sq_size;
+	void *p_cq_ptr;
+	size_t m_cq_size;
+	void *p_sqes;
+	size_t m_sqes_size;
+
+	unsigned *p_sq_head;
+	unsigned *p_sq_tail;
+	unsigned m_sq_mask;
+	unsigned *p_sq_array;
+	unsigned m_sq_entries;
+
+	unsigned *p_cq_head;
+	unsigned *p_cq_tail;
+	unsigned m_cq_mask;
+	void *p_cqes;
+
+	///prepared but not submitted entries (locked by m_submit_lock)
+	unsigned m_prepared;
+
+	///completion thread
+	pthread_t m_completion_thread;
+#endif
+
+	/**
+	 * handle queued operations (emulation thread)
+	 */
+	void emulation_func(void);
+
+	static void *pthread_completion(void *ptr);
+	static void *pthread_emulation(void *ptr);
+
+	ThreadPool *p_pool;
+
+	///thread based emulation in use
+	bool m_emulated;
+
+	///limit of operations in flight
+	uint32_t m_entries;
+
+	///count of submitted but not completed operations
+	std::atomic<uint32_t> m_inflight;
+
+	///lock submission ring/emulation queue
+	std::mutex m_submit_lock;
+
+	///emulation queue (locked by m_submit_lock)
+	std::deque<IoRequest> m_emu_queue;
+
+	///signaled on new emulation requests/stop
+	std::condition_variable m_emu_cond;
+
+	///running flag of emulation threads (locked by m_submit_lock)
+	bool m_emu_running;
+
+	///emulation threads
+	std::vector<pthread_t> m_emu_threads;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* ASYNCIO_H_ */
@@ -0,0 +1,570 @@
+/**
+ * @file   BasicThreadPool.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Header-only thread pool template configured by policy classes (queue, wakeup, scaling, timer)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef BASICTHREADPOOL_H_
+#define BASICTHREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+
+//C++11
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ThreadPoolInt/BasePoolInt.h"
+
+//logging macros
+#ifndef BasicThreadPool_log_error
+	#define BasicThreadPool_log_error(...)
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Handling of queued tasks by BasicThreadPool
+/**
+ * default: callable objects (std::function, lambdas, ...) -> operator(), nothing to release
+ * specialize it for own task types
+ */
+template <class Task>
+struct TaskTraits {
+	static void execute(Task &task){ task(); }
+	static void release(Task &){}
+};
+
+///FunctorInt objects: functor_execute, functor_release for unhandled ones
+template <>
+struct TaskTraits<FunctorInt*> {
+	static void execute(FunctorInt *&task){ task->functor_execute(); }
+	static void release(FunctorInt *&task){ task->functor_release(); }
+};
+
+/**
+ * Queue policies
+ * - bool push(const Task &task, ...) (false: full), bool pop(Task &task), size_t size()
+ * - called with pool lock held
+ */
+
+///FIFO queue with fixed maximum size
+template <class Task, size_t Max = FUNCTOR_MAX>
+class FifoQueue {
+public:
+	typedef Task value_type;
+
+	bool push(const Task &task){
+		if (m_tasks.size() >= Max)
+		{
+			return false;
+		}
+		m_tasks.push_back(task);
+		return true;
+	}
+
+	bool pop(Task &task){
+		if (m_tasks.empty())
+		{
+			return false;
+		}
+		task = m_tasks.front();
+		m_tasks.pop_front();
+		return true;
+	}
+
+	size_t size(void) const { return m_tasks.size(); }
+
+private:
+	std::deque<Task> m_tasks;
+};
+
+///Priority queue (highest priority first, FIFO within a priority) with fixed maximum size
+template <class Task, size_t Max = FUNCTOR_MAX>
+class PrioQueue {
+public:
+	typedef Task value_type;
+
+	PrioQueue():m_seq(0){};
+
+	bool push(const Task &task, uint8_t priority = 0){
+		if (m_heap.size() >= Max)
+		{
+			return false;
+		}
+		Entry entry = { priority, m_seq++, task };
+		m_heap.push_back(entry);
+		std::push_heap(m_heap.begin(), m_heap.end());
+		return true;
+	}
+
+	bool pop(Task &task){
+		if (m_heap.empty())
+		{
+			return false;
+		}
+		task = m_heap.front().task;
+		std::pop_heap(m_heap.begin(), m_heap.end());
+		m_heap.pop_back();
+		return true;
+	}
+
+	size_t size(void) const { return m_heap.size(); }
+
+private:
+	struct Entry {
+		uint8_t priority;
+		uint64_t seq;
+		Task task;
+
+		bool operator<(const Entry &other) const {
+			return (priority != other.priority) ? priority < other.priority : seq > other.seq;
+		}
+	};
+
+	std::vector<Entry> m_heap;
+	uint64_t m_seq;
+};
+
+/**
+ * Wake policies
+ * - bool waitUntil(lock, deadline, pred): wait until pred() (true) or deadline (false)
+ * - notifyOne/notifyAll: called with pool lock held
+ */
+
+///Idle workers park on a condition variable
+class CondVarWake {
+public:
+	template <class Pred>
+	bool waitUntil(std::unique_lock<std::mutex> &lock, std::chrono::steady_clock::time_point deadline, Pred pred){
+		if (deadline == std::chrono::steady_clock::time_point::max())
+		{
+			m_cond.wait(lock, pred);
+			return true;
+		}
+		return m_cond.wait_until(lock, deadline, pred);
+	}
+
+	void notifyOne(void){ m_cond.notify_one(); }
+	void notifyAll(void){ m_cond.notify_all(); }
+
+private:
+	std::condition_variable m_cond;
+};
+
+///Idle workers yield Spins times before parking (lower latency for bursts, more cpu load)
+template <uint32_t Spins = 64>
+class SpinWake {
+public:
+	template <class Pred>
+	bool waitUntil(std::unique_lock<std::mutex> &lock, std::chrono::steady_clock::time_point deadline, Pred pred){
+		for (uint32_t i = 0; i < Spins; i++)
+		{
+			if (pred())
+			{
+				return true;
+			}
+			lock.unlock();
+			sched_yield();
+			lock.lock();
+		}
+		return m_park.waitUntil(lock, deadline, pred);
+	}
+
+	void notifyOne(void){ m_park.notifyOne(); }
+	void notifyAll(void){ m_park.notifyAll(); }
+
+private:
+	CondVarWake m_park;
+};
+
+/**
+ * Scaling policies
+ * - dynamic: false -> worker count is never changed (checks are removed at compile time)
+ * - initialCount, grow (on submit without idle worker), retire (after idleTimeout)
+ */
+
+///Fixed worker count
+class FixedScaling {
+public:
+	static const bool dynamic = false;
+
+	static size_t initialCount(size_t requested){ return requested > 0 ? requested : 1; }
+	static bool grow(size_t, size_t, size_t){ return false; }
+	static bool retire(size_t){ return false; }
+	static std::chrono::steady_clock::duration idleTimeout(void){ return std::chrono::steady_clock::duration::max(); }
+};
+
+///Worker count between Low and High, idle workers above Low retire after IdleMs
+template <size_t Low, size_t High, uint32_t IdleMs = 1000>
+class DynamicScaling {
+public:
+	static_assert(Low >= 1 && Low <= High, "DynamicScaling: 1 <= Low <= High");
+
+	static const bool dynamic = true;
+
+	static size_t initialCount(size_t requested){
+		return requested < Low ? Low : (requested > High ? High : requested);
+	}
+	static bool grow(size_t workers, size_t idle, size_t queued){ return workers < High && queued > idle; }
+	static bool retire(size_t workers){ return workers > Low; }
+	static std::chrono::steady_clock::duration idleTimeout(void){ return std::chrono::milliseconds(IdleMs); }
+};
+
+/**
+ * Timer policies
+ * - bool popDue(Task &task), bool popAny(Task &task), time_point nextDue(), size_t size()
+ * - add(task, due) only needed for submitAfter
+ */
+
+///No delayed tasks (submitAfter not available)
+class NoTimer {
+public:
+	template <class Task>
+	bool popDue(Task &){ return false; }
+	template <class Task>
+	bool popAny(Task &){ return false; }
+	std::chrono::steady_clock::time_point nextDue(void){ return std::chrono::steady_clock::time_point::max(); }
+	size_t size(void) const { return 0; }
+};
+
+///Delayed tasks within a min heap, handled by idle workers (no timer thread)
+template <class Task, size_t Max = FUNCTOR_MAX>
+class HeapTimer {
+public:
+	typedef Task value_type;
+
+	HeapTimer():m_seq(0){};
+
+	bool add(const Task &task, std::chrono::steady_clock::time_point due){
+		if (m_heap.size() >= Max)
+		{
+			return false;
+		}
+		Entry entry = { due, m_seq++, task };
+		m_heap.push_back(entry);
+		std::push_heap(m_heap.begin(), m_heap.end());
+		return true;
+	}
+
+	/**
+	 * take task with passed due time
+	 */
+	bool popDue(Task &task){
+		return !m_heap.empty() && m_heap.front().due <= std::chrono::steady_clock::now() && popAny(task);
+	}
+
+	/**
+	 * take earliest task (also if not due)
+	 */
+	bool popAny(Task &task){
+		if (m_heap.empty())
+		{
+			return false;
+		}
+		task = m_heap.front().task;
+		std::pop_heap(m_heap.begin(), m_heap.end());
+		m_heap.pop_back();
+		return true;
+	}
+
+	std::chrono::steady_clock::time_point nextDue(void){
+		return m_heap.empty() ? std::chrono::steady_clock::time_point::max() : m_heap.front().due;
+	}
+
+	size_t size(void) const { return m_heap.size(); }
+
+private:
+	struct Entry {
+		std::chrono::steady_clock::time_point due;
+		uint64_t seq;
+		Task task;
+
+		bool operator<(const Entry &other) const {
+			// inverted -> std heap functions build a min heap
+			return (due != other.due) ? due > other.due : seq > other.seq;
+		}
+	};
+
+	std::vector<Entry> m_heap;
+	uint64_t m_seq;
+};
+
+///Thread pool template
+/**
+ * Features are selected by policy classes instead of NO_*_TP_SUPPORT macros and virtual interfaces:
+ * all policy calls are direct (inlinable) and pools with different policies coexist within one binary.
+ * Example: BasicThreadPool<PrioQueue<FunctorInt*>, CondVarWake, DynamicScaling<2, 8>, HeapTimer<FunctorInt*> >
+ *
+ * Tasks are handled by TaskTraits<task_type> (FunctorInt*: functor_execute, callables: operator()).
+ * Not handled tasks are released on shutdown/destruction (FunctorInt*: functor_release).
+ * ThreadPool remains the full featured pool (runtime configuration, reactor, tenants, ...).
+ */
+template <class Queue = FifoQueue<FunctorInt*>, class Wake = CondVarWake, class Scaling = FixedScaling, class Timer = NoTimer>
+class BasicThreadPool {
+public:
+	typedef typename Queue::value_type task_type;
+
+	/**
+	 * @param worker_count	initial count of workers (limited by scaling policy)
+	 */
+	explicit BasicThreadPool(size_t worker_count = 1):
+		m_running(true),
+		m_idle(0),
+		m_timer_gen(0)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		size_t count = Scaling::initialCount(worker_count);
+
+		while (m_threads.size() < count && addWorker()){}
+
+		if (m_threads.empty())
+		{
+			m_running = false;
+			throw std::runtime_error("icke2063::BasicThreadPool: Cannot create Worker\n");
+		}
+	}
+
+	/**
+	 * - release queued tasks, wait for running ones
+	 */
+	~BasicThreadPool(){ shutdown(false); }
+
+	/**
+	 * add task
+	 * @param args	additional queue parameters (e.g. priority of PrioQueue)
+	 * @return false if not added (queue full, pool stopped) -> task still owned by caller
+	 */
+	template <typename... Args>
+	bool submit(const task_type &task, Args... args){
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_running || !m_queue.push(task, args...))
+		{
+			return false;
+		}
+
+		if (m_idle > 0)
+		{
+			m_wake.notifyOne();
+		}
+		else if (Scaling::dynamic && Scaling::grow(m_threads.size(), m_idle, m_queue.size()))
+		{
+			addWorker();
+		}
+		return true;
+	}
+
+	/**
+	 * add task handled after delay (Timer policy with add, e.g. HeapTimer)
+	 * @return false if not added (timer full, pool stopped)
+	 */
+	bool submitAfter(const task_type &task, std::chrono::steady_clock::duration delay){
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_running || !m_timer.add(task, std::chrono::steady_clock::now() + delay))
+		{
+			return false;
+		}
+
+		// idle worker has to wait for new earliest due time
+		m_timer_gen++;
+		if (m_idle > 0)
+		{
+			m_wake.notifyOne();
+		}
+		return true;
+	}
+
+	/**
+	 * stop pool: refuse new tasks, release delayed tasks, join all workers
+	 * - must not be called by a worker of this pool
+	 * @param drain		handle queued tasks before (else release them)
+	 */
+	void shutdown(bool drain = true){
+		std::vector<pthread_t> threads;
+		task_type task;
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+
+			m_running = false;
+			while (!drain && m_queue.pop(task))
+			{
+				TaskTraits<task_type>::release(task);
+			}
+			m_wake.notifyAll();
+
+			// no retiring worker after reset of running flag
+			threads.swap(m_threads);
+			threads.insert(threads.end(), m_retired.begin(), m_retired.end());
+			m_retired.clear();
+		}
+
+		std::vector<pthread_t>::iterator thread_it = threads.begin();
+		while (thread_it != threads.end())
+		{
+			pthread_join(*thread_it, NULL);
+			++thread_it;
+		}
+
+		// never due
+		std::lock_guard<std::mutex> lock(m_lock);
+		while (m_timer.popAny(task))
+		{
+			TaskTraits<task_type>::release(task);
+		}
+	}
+
+	size_t getWorkerCount(void){ std::lock_guard<std::mutex> lock(m_lock); return m_threads.size(); }
+	size_t getIdleCount(void){ std::lock_guard<std::mutex> lock(m_lock); return m_idle; }
+	size_t getQueueCount(void){ std::lock_guard<std::mutex> lock(m_lock); return m_queue.size(); }
+	size_t getTimerCount(void){ std::lock_guard<std::mutex> lock(m_lock); return m_timer.size(); }
+
+private:
+	BasicThreadPool(const BasicThreadPool &);
+	BasicThreadPool &operator=(const BasicThreadPool &);
+
+	/**
+	 * start new worker, join retired ones
+	 * - m_lock has to be locked by caller
+	 */
+	bool addWorker(void){
+		pthread_t thread;
+
+		// retired workers do not need the lock anymore
+		std::vector<pthread_t>::iterator retired_it = m_retired.begin();
+		while (retired_it != m_retired.end())
+		{
+			pthread_join(*retired_it, NULL);
+			++retired_it;
+		}
+		m_retired.clear();
+
+		int result = pthread_create(&thread, NULL, pthread_func, this);
+		if (0 != result)
+		{
+			BasicThreadPool_log_error("BasicThreadPool: create worker failure: %i\n", result);
+			return false;
+		}
+		m_threads.push_back(thread);
+		return true;
+	}
+
+	static void *pthread_func(void *ptr){
+		static_cast<BasicThreadPool*>(ptr)->worker_function();
+		return NULL;
+	}
+
+	void worker_function(void){
+		std::unique_lock<std::mutex> lock(m_lock);
+		task_type task;
+
+		while (true)
+		{
+			if (m_timer.popDue(task) || m_queue.pop(task))
+			{
+				lock.unlock();
+				try
+				{
+					TaskTraits<task_type>::execute(task);
+				}
+				catch (...)
+				{
+					BasicThreadPool_log_error("BasicThreadPool: exception within task\n");
+				}
+				lock.lock();
+				continue;
+			}
+
+			if (!m_running)
+			{
+				return;	// queue drained/released
+			}
+
+			std::chrono::steady_clock::time_point deadline = m_timer.nextDue();
+			std::chrono::steady_clock::time_point idle_deadline = std::chrono::steady_clock::time_point::max();
+			if (Scaling::dynamic)
+			{
+				idle_deadline = std::chrono::steady_clock::now() + Scaling::idleTimeout();
+				deadline = std::min(deadline, idle_deadline);
+			}
+
+			uint64_t timer_gen = m_timer_gen;
+			m_idle++;
+			bool signaled = m_wake.waitUntil(lock, deadline, [this, timer_gen]{
+				return !m_running || m_queue.size() > 0 || m_timer_gen != timer_gen;
+			});
+			m_idle--;
+
+			if (Scaling::dynamic && !signaled && Scaling::retire(m_threads.size())
+					&& std::chrono::steady_clock::now() >= idle_deadline)
+			{
+				// idle too long -> leave pool (joined by addWorker/shutdown)
+				std::vector<pthread_t>::iterator thread_it = m_threads.begin();
+				while (thread_it != m_threads.end() && !pthread_equal(*thread_it, pthread_self()))
+				{
+					++thread_it;
+				}
+				if (thread_it != m_threads.end())
+				{
+					m_threads.erase(thread_it);
+					m_retired.push_back(pthread_self());
+					return;
+				}
+			}
+		}
+	}
+
+	///lock of queue, timer and worker lists
+	std::mutex m_lock;
+
+	Queue m_queue;
+	Wake m_wake;
+	Timer m_timer;
+
+	///running flag (locked by m_lock)
+	bool m_running;
+
+	///count of waiting workers (locked by m_lock)
+	size_t m_idle;
+
+	///changed on each submitAfter -> waiting workers take new earliest due time
+	uint64_t m_timer_gen;
+
+	///running workers
+	std::vector<pthread_t> m_threads;
+
+	///workers left by scaling, not joined yet
+	std::vector<pthread_t> m_retired;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* BASICTHREADPOOL_H_ */
@@ -0,0 +1,169 @@
+/**
+ * @file   CompletionEvent.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Futex based completion signal shared by TaskGroup, TaskGraph and Strand
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef COMPLETIONEVENT_H_
+#define COMPLETIONEVENT_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <sched.h>
+
+//C++11
+#include <atomic>
+#include <chrono>
+
+//common_cpp
+#include <ThreadPool.h>
+#include "Futex.h"
+
+/**
+ * maximum blocking time per turn of a waiting WorkerThread (awaited functor may be queued behind it later)
+ */
+#ifndef TP_COMPLETION_POLL_US
+	#define TP_COMPLETION_POLL_US	1000
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Completion signal of an object awaited by other threads
+/**
+ * Completing threads change the state of the owner object and call notify within an enter/leave bracket.
+ * Waiting threads are parked on a futex word (no syscall on notify without waiter). A waiting WorkerThread
+ * of the pool handles queued functors meanwhile instead of blocking its worker slot.
+ * The owner calls drain before its members are destroyed -> no completing thread accesses it afterwards.
+ */
+class CompletionEvent {
+public:
+	CompletionEvent(ThreadPool *pool):
+		p_pool(pool),
+		m_event(0),
+		m_waiters(0),
+		m_signaling(0)
+	{
+	}
+
+	/**
+	 * completing thread starts accessing owner object
+	 */
+	void enter(void){ m_signaling.fetch_add(1, std::memory_order_acq_rel); }
+
+	/**
+	 * last access of completing thread to owner object
+	 */
+	void leave(void){ m_signaling.fetch_sub(1, std::memory_order_release); }
+
+	/**
+	 * wakeup waiting threads (state of owner object changed before)
+	 */
+	void notify(void)
+	{
+		m_event.fetch_add(1, std::memory_order_seq_cst);
+		if (m_waiters.load(std::memory_order_seq_cst) > 0)
+		{
+			futex_wake(&m_event);
+		}
+	}
+
+	/**
+	 * wait for completing threads leaving owner object (destructor of owner)
+	 */
+	void drain(void)
+	{
+		while (m_signaling.load(std::memory_order_acquire) > 0)
+		{
+			sched_yield();
+		}
+	}
+
+	/**
+	 * wait until condition function returns true (checked after each notify)
+	 * @param timeout_ms	maximum time to wait (<0: wait forever)
+	 * @return true if condition is met, false on timeout
+	 */
+	template <typename Cond>
+	bool waitFor(Cond cond, int32_t timeout_ms = -1)
+	{
+		std::chrono::steady_clock::time_point deadline =
+				std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+		bool helping = p_pool && p_pool->isWorkerThread();
+
+		while (true)
+		{
+			int32_t event = m_event.load(std::memory_order_seq_cst);
+			int64_t timeout_us = -1;
+
+			if (cond())
+			{
+				return true;
+			}
+
+			if (timeout_ms >= 0)
+			{
+				timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(
+						deadline - std::chrono::steady_clock::now()).count();
+				if (timeout_us <= 0)
+				{
+					return false;
+				}
+			}
+
+			if (helping)
+			{
+				// own worker -> handle queued functors instead of blocking the worker slot
+				if (p_pool->runPendingFunctor())
+				{
+					continue;
+				}
+				if (timeout_us < 0 || timeout_us > TP_COMPLETION_POLL_US)
+				{
+					timeout_us = TP_COMPLETION_POLL_US;
+				}
+			}
+
+			m_waiters.fetch_add(1, std::memory_order_seq_cst);
+			if (m_event.load(std::memory_order_seq_cst) == event)
+			{
+				futex_wait(&m_event, event, timeout_us);
+			}
+			m_waiters.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+private:
+	ThreadPool *p_pool;
+
+	///futex word: changed on each notify
+	std::atomic<int32_t> m_event;
+
+	///count of threads waiting on futex
+	std::atomic<int32_t> m_waiters;
+
+	///count of completing threads within owner object
+	std::atomic<int32_t> m_signaling;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* COMPLETIONEVENT_H_ */
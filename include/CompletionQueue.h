@@ -0,0 +1,151 @@
+/**
+ * @file   CompletionQueue.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Lock-free completion queue with eventfd notification (bridge to external event loops)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef COMPLETIONQUEUE_H_
+#define COMPLETIONQUEUE_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <stddef.h>
+
+//C++11
+#include <atomic>
+
+//common_cpp
+#include <ThreadPool.h>
+#include "MpscQueue.h"
+
+//logging macros
+#ifndef CompletionQueue_log_error
+	#define CompletionQueue_log_error(...)
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+class CompletionQueue;
+
+///Node of completion queue
+struct CompletionNode {
+	std::atomic<CompletionNode*> next;
+	FunctorInt *functor;
+};
+
+///Functor for the pool: handle work, then post completion functor to CompletionQueue
+/**
+ * The completion functor is released without posting if the work functor is removed unhandled.
+ */
+class PostFunctor: public Functor {
+public:
+	PostFunctor(CompletionQueue *queue, FunctorInt *work, FunctorInt *completion);
+	virtual ~PostFunctor();
+
+	virtual void functor_function(void) TP_OVERRIDE;
+
+private:
+	CompletionQueue *p_queue;
+	FunctorInt *p_work;
+	FunctorInt *p_completion;
+};
+
+///Queue of completion functors handled by the thread of an external event loop
+/**
+ * Any thread posts functors (lock-free multi producer/single consumer queue). The eventfd of the queue
+ * gets readable when the first functor is posted to the empty queue -> add getFd() to the external
+ * poll/epoll/select loop and call drain() if readable. No polling, one wakeup per batch.
+ *
+ * Pool functors are bound to the queue by wrap():
+ * - work completed:	pool->delegateFunctor(queue.wrap(work, completion));
+ * - delayed functor due:	pool->delegateDelayedFunctor(... new DelayedFunctor(queue.wrap(NULL, completion), deadline) ...);
+ *
+ * The queue object is owned by the caller and has to stay alive until all wrapped functors are handled.
+ */
+class CompletionQueue {
+public:
+	/**
+	 * - create eventfd (check isValid)
+	 */
+	CompletionQueue();
+
+	/**
+	 * - release not drained functors, close eventfd
+	 */
+	virtual ~CompletionQueue();
+
+	/**
+	 * check if eventfd could be created
+	 */
+	bool isValid(void){return m_event_fd >= 0;}
+
+	/**
+	 * get eventfd (readable if functors are posted)
+	 */
+	int getFd(void){return m_event_fd;}
+
+	/**
+	 * Post functor (any thread)
+	 * - signal eventfd only if queue was empty
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+	FunctorInt *post(FunctorInt *functor);
+
+	/**
+	 * handle posted functors within calling thread (one thread only)
+	 * @param max_count	maximum count of functors to handle (remaining ones signal the eventfd again)
+	 * @return count of handled functors
+	 */
+	size_t drain(size_t max_count = SIZE_MAX);
+
+	/**
+	 * create pool functor: handle work (may be NULL), then post completion
+	 */
+	FunctorInt *wrap(FunctorInt *work, FunctorInt *completion){
+		return new PostFunctor(this, work, completion);
+	}
+
+	/**
+	 * get count of posted but not drained functors
+	 */
+	int32_t getPendingCount(void){ return m_count.load(std::memory_order_acquire); }
+
+private:
+	/**
+	 * make eventfd readable
+	 */
+	void signal(void);
+
+	///eventfd for external event loop
+	int m_event_fd;
+
+	///posted functors (consumer: thread calling drain)
+	MpscQueue<CompletionNode> m_queue;
+
+	///count of posted but not drained functors (0 -> next post signals eventfd)
+	std::atomic<int32_t> m_count;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* COMPLETIONQUEUE_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file   Futex.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Minimal futex wrapper for waiting on atomic 32bit counters (linux only)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef FUTEX_H_
+#define FUTEX_H_
+
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//C++11
+#include <atomic>
+
+namespace icke2063 {
+namespace threadpool {
+
+static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "futex needs plain 32bit atomic");
+
+/**
+ * block calling thread while *word == expected
+ * @param word		futex word
+ * @param expected	value seen by caller before waiting
+ * @param timeout_us	relative timeout in microseconds (<0: wait forever)
+ * @return 0 on wakeup, else errno value (EAGAIN: value changed, ETIMEDOUT, EINTR)
+ */
+inline int futex_wait(std::atomic<int32_t> *word, int32_t expected, int64_t timeout_us = -1)
+{
+	struct timespec ts;
+	struct timespec *p_ts = NULL;
+
+	if (timeout_us >= 0)
+	{
+		ts.tv_sec = timeout_us / 1000000;
+		ts.tv_nsec = (timeout_us % 1000000) * 1000;
+		p_ts = &ts;
+	}
+
+	if (0 != syscall(SYS_futex, reinterpret_cast<int32_t*>(word), FUTEX_WAIT_PRIVATE, expected, p_ts, NULL, 0))
+	{
+		return errno;
+	}
+	return 0;
+}
+
+/**
+ * wakeup threads blocked in futex_wait on given word
+ * @param count		maximum count of threads to wake
+ */
+inline void futex_wake(std::atomic<int32_t> *word, int32_t count = INT32_MAX)
+{
+	syscall(SYS_futex, reinterpret_cast<int32_t*>(word), FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* FUTEX_H_ */
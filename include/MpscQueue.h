@@ -0,0 +1,120 @@
+/**
+ * @file   MpscQueue.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Intrusive lock-free multi producer/single consumer queue (Vyukov)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MPSCQUEUE_H_
+#define MPSCQUEUE_H_
+
+#include <stddef.h>
+
+//C++11
+#include <atomic>
+
+namespace icke2063 {
+namespace threadpool {
+
+///Intrusive multi producer/single consumer queue (used by Strand and CompletionQueue)
+/**
+ * Node has to provide a member "std::atomic<Node*> next" and a default constructor.
+ * push is wait-free for any thread, pop is called by one consumer at a time only.
+ * Nodes are owned by the caller (no allocation within the queue).
+ */
+template <typename Node>
+class MpscQueue {
+public:
+	MpscQueue():
+		m_head(&m_stub),
+		m_tail(&m_stub),
+		m_stub()
+	{
+		m_stub.next.store(NULL, std::memory_order_relaxed);
+	}
+
+	/**
+	 * add node to queue (any thread)
+	 */
+	void push(Node *node)
+	{
+		node->next.store(NULL, std::memory_order_relaxed);
+		Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	/**
+	 * get oldest node from queue (consumer only)
+	 * @return NULL if empty or a producer did not finish push yet
+	 */
+	Node *pop(void)
+	{
+		Node *tail = m_tail;
+		Node *next = tail->next.load(std::memory_order_acquire);
+
+		if (tail == &m_stub)
+		{
+			if (next == NULL)
+			{
+				return NULL;
+			}
+			m_tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (next)
+		{
+			m_tail = next;
+			return tail;
+		}
+
+		if (tail != m_head.load(std::memory_order_acquire))
+		{
+			return NULL;	// producer between exchange and link
+		}
+
+		// last node: put stub behind it to keep one node within queue
+		push(&m_stub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next)
+		{
+			m_tail = next;
+			return tail;
+		}
+		return NULL;
+	}
+
+private:
+	MpscQueue(const MpscQueue&);
+	MpscQueue &operator=(const MpscQueue&);
+
+	///producer side: last added node
+	std::atomic<Node*> m_head;
+
+	///consumer side: oldest node
+	Node *m_tail;
+
+	///placeholder node (queue never gets empty)
+	Node m_stub;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* MPSCQUEUE_H_ */
@@ -0,0 +1,228 @@
+/**
+ * @file   ParallelFor.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  parallel_for on top of ThreadPool with lazy binary splitting of index ranges
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stddef.h>
+
+//common_cpp
+#include <ThreadPool.h>
+#include <TaskGroup.h>
+
+/**
+ * size of cache line in bytes (used for alignment of chunk boundaries)
+ */
+#ifndef TP_CACHELINE_SIZE
+	#define TP_CACHELINE_SIZE	64
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Shared state of one parallel_for call
+/**
+ * Lazy binary splitting: a range is only split while the pool shows demand for work
+ * (empty functor queue, not too many open ranges). Otherwise the range is handled chunk by chunk (grain size) and
+ * the demand is checked again after each chunk. Split points are aligned to cache lines
+ * if the element size is known, so two workers never write into the same cache line.
+ */
+template <typename Body>
+class ParallelForRange {
+public:
+	ParallelForRange(ThreadPool *pool, TaskGroup *group, const Body &body, size_t grain, size_t elem_size):
+		p_pool(pool), p_group(group), m_body(body), m_grain(grain > 0 ? grain : 1), m_align(1)
+	{
+		if (elem_size > 0 && elem_size < TP_CACHELINE_SIZE && (TP_CACHELINE_SIZE % elem_size) == 0)
+		{
+			m_align = TP_CACHELINE_SIZE / elem_size;
+			m_grain = ((m_grain + m_align - 1) / m_align) * m_align;	// round up to full cache lines
+		}
+	}
+
+	/**
+	 * handle given index range (split on demand)
+	 */
+	void execute(size_t begin, size_t end);
+
+private:
+	/**
+	 * check if other workers wait for work
+	 * - empty functor queue and less delegated ranges than 2 per worker
+	 */
+	bool splitDemand(void){
+		return p_pool->getQueueCount() == 0
+				&& (size_t)p_group->getPendingCount() < 2 * p_pool->getWorkerCount();
+	}
+
+	/**
+	 * inner loop without member access (lets the compiler keep everything in registers)
+	 */
+	static void runChunk(const Body &body, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			body(i);
+		}
+	}
+
+	/**
+	 * delegate index range to pool
+	 * @return false if pool did not take it
+	 */
+	bool delegateRange(size_t begin, size_t end);
+
+	ThreadPool *p_pool;
+	TaskGroup *p_group;
+	const Body &m_body;
+	size_t m_grain;
+	size_t m_align;
+};
+
+///Functor for delegated part of a parallel_for range
+template <typename Body>
+class ParallelForFunctor: public Functor {
+public:
+	ParallelForFunctor(ParallelForRange<Body> *range, TaskGroup *group, size_t begin, size_t end):
+		p_range(range), p_group(group), m_begin(begin), m_end(end) {}
+
+	/**
+	 * - signal completion to group
+	 */
+	virtual ~ParallelForFunctor(){ p_group->functorDone(); }
+
+	virtual void functor_function(void) TP_OVERRIDE { p_range->execute(m_begin, m_end); }
+
+	/**
+	 * handle range, then delete object (functor_release is only used for unhandled ranges)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE {
+		try
+		{
+			functor_function();
+		}
+		catch (...)
+		{
+			delete this;
+			throw;
+		}
+		delete this;
+	}
+
+	/**
+	 * released unhandled by pool -> handle range within releasing thread (no index is skipped)
+	 */
+	virtual void functor_release(void) TP_OVERRIDE {
+		try
+		{
+			functor_function();
+		}
+		catch (...)
+		{
+			// ignored like exceptions of handled functors (WorkerThread::executeFunctor)
+		}
+		delete this;
+	}
+
+private:
+	ParallelForRange<Body> *p_range;
+	TaskGroup *p_group;
+	size_t m_begin;
+	size_t m_end;
+};
+
+template <typename Body>
+bool ParallelForRange<Body>::delegateRange(size_t begin, size_t end)
+{
+	ParallelForFunctor<Body> *functor = new ParallelForFunctor<Body>(this, p_group, begin, end);
+
+	p_group->addPending();
+	if (p_pool->delegateFunctor(functor) == NULL)
+	{
+		return true;
+	}
+
+	// not added -> destructor balances addPending
+	delete functor;
+	return false;
+}
+
+template <typename Body>
+void ParallelForRange<Body>::execute(size_t begin, size_t end)
+{
+	while (begin < end)
+	{
+		size_t size = end - begin;
+
+		if (size > m_grain && splitDemand())
+		{
+			// split in the middle (aligned to cache line) and give away upper half
+			size_t mid = begin + size / 2;
+			mid -= (mid % m_align);
+
+			if (mid > begin && delegateRange(mid, end))
+			{
+				end = mid;
+				continue;
+			}
+		}
+
+		// handle one chunk, then check demand again
+		size_t chunk_end = (size > m_grain) ? begin + m_grain : end;
+		runChunk(m_body, begin, chunk_end);
+		begin = chunk_end;
+	}
+}
+
+/**
+ * call body(i) for each index i within [begin, end) using the WorkerThreads of pool
+ * - the calling thread handles a part of the range itself and waits for the rest
+ * - ranges are split recursively as long as the pool has demand for work
+ * @param pool		ThreadPool object
+ * @param begin		first index
+ * @param end		index after last index
+ * @param grain		minimum count of indexes handled as one chunk
+ * @param body		function object called with each index (has to be thread safe)
+ * @param elem_size	size of one element of contiguous data (0: no cache line alignment)
+ */
+template <typename Body>
+void parallel_for(ThreadPool *pool, size_t begin, size_t end, size_t grain, const Body &body,
+		size_t elem_size = 0)
+{
+	if (begin >= end)
+	{
+		return;
+	}
+
+	TaskGroup group(pool);
+	ParallelForRange<Body> range(pool, &group, body, grain, elem_size);
+
+	range.execute(begin, end);
+	group.waitAll();
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* PARALLELFOR_H_ */
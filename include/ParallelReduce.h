@@ -0,0 +1,315 @@
+/**
+ * @file   ParallelReduce.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  parallel reduce, transform-reduce and prefix-scan on top of ThreadPool
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef PARALLELREDUCE_H_
+#define PARALLELREDUCE_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+//C++11
+#include <new>
+#include <vector>
+#include <iterator>
+#include <type_traits>
+
+//common_cpp
+#include <ParallelFor.h>
+
+/**
+ * minimum count of elements handled by one block
+ */
+#ifndef TP_PARALLEL_MIN_BLOCK
+	#define TP_PARALLEL_MIN_BLOCK	1024
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Partial result of one block, aligned to full cache lines (no false sharing between workers)
+template <typename T>
+struct alignas(TP_CACHELINE_SIZE) PaddedPartial {
+	T value;
+	bool valid;
+};
+
+///Allocator with cache line aligned storage (operator new ignores over-alignment before C++17)
+template <typename T>
+struct CachelineAllocator {
+	typedef T value_type;
+
+	CachelineAllocator() {}
+	template <typename U>
+	CachelineAllocator(const CachelineAllocator<U> &) {}
+
+	T *allocate(size_t n)
+	{
+		void *ptr = NULL;
+		if (posix_memalign(&ptr, TP_CACHELINE_SIZE, n * sizeof(T)) != 0)
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(ptr);
+	}
+
+	void deallocate(T *ptr, size_t) { free(ptr); }
+};
+
+template <typename T, typename U>
+bool operator==(const CachelineAllocator<T> &, const CachelineAllocator<U> &) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const CachelineAllocator<T> &, const CachelineAllocator<U> &) { return false; }
+
+///list of partial results (one per block)
+template <typename T>
+using PartialList = std::vector<PaddedPartial<T>, CachelineAllocator<PaddedPartial<T> > >;
+
+/**
+ * get count of blocks for given element count
+ * - one block per worker plus one for the calling thread
+ */
+inline size_t parallel_block_count(ThreadPool *pool, size_t count)
+{
+	size_t blocks = pool->getWorkerCount() + 1;
+	size_t max_blocks = count / TP_PARALLEL_MIN_BLOCK;
+
+	if (blocks > max_blocks)
+	{
+		blocks = (max_blocks > 0) ? max_blocks : 1;
+	}
+	return blocks;
+}
+
+/**
+ * serial reduce of [first, first + count) starting with first element
+ * - arithmetic types: four independent accumulators (no dependency chain -> vectorizable)
+ */
+template <typename T, typename It, typename BinaryOp, typename UnaryOp>
+T serial_transform_reduce(It first, size_t count, BinaryOp reduce_op, UnaryOp transform_op)
+{
+	size_t i = 1;
+	T acc = transform_op(first[0]);
+
+	if (std::is_arithmetic<T>::value && count >= 8)
+	{
+		T acc1 = transform_op(first[1]);
+		T acc2 = transform_op(first[2]);
+		T acc3 = transform_op(first[3]);
+
+		for (i = 4; i + 4 <= count; i += 4)
+		{
+			acc = reduce_op(acc, transform_op(first[i]));
+			acc1 = reduce_op(acc1, transform_op(first[i + 1]));
+			acc2 = reduce_op(acc2, transform_op(first[i + 2]));
+			acc3 = reduce_op(acc3, transform_op(first[i + 3]));
+		}
+		acc = reduce_op(reduce_op(acc, acc1), reduce_op(acc2, acc3));
+	}
+
+	for (; i < count; ++i)
+	{
+		acc = reduce_op(acc, transform_op(first[i]));
+	}
+	return acc;
+}
+
+/**
+ * combine partial results pairwise (tree) into partials[0]
+ */
+template <typename T, typename BinaryOp>
+void tree_combine(PartialList<T> &partials, BinaryOp reduce_op)
+{
+	for (size_t stride = 1; stride < partials.size(); stride *= 2)
+	{
+		for (size_t i = 0; i + stride < partials.size(); i += 2 * stride)
+		{
+			if (partials[i + stride].valid)
+			{
+				partials[i].value = partials[i].valid ?
+						reduce_op(partials[i].value, partials[i + stride].value) : partials[i + stride].value;
+				partials[i].valid = true;
+			}
+		}
+	}
+}
+
+/**
+ * reduce transformed elements of [first, last) using the WorkerThreads of pool
+ * - reduce_op has to be associative and commutative
+ * @param pool		ThreadPool object
+ * @param first		random access iterator to first element
+ * @param last		random access iterator behind last element
+ * @param init		initial value
+ * @param reduce_op	binary operation T(T, T)
+ * @param transform_op	unary operation T(element)
+ * @return init reduced with all transformed elements
+ */
+template <typename T, typename It, typename BinaryOp, typename UnaryOp>
+T parallel_transform_reduce(ThreadPool *pool, It first, It last, T init, BinaryOp reduce_op, UnaryOp transform_op)
+{
+	size_t count = std::distance(first, last);
+
+	if (count == 0)
+	{
+		return init;
+	}
+
+	size_t blocks = parallel_block_count(pool, count);
+	size_t block_size = (count + blocks - 1) / blocks;
+	PartialList<T> partials(blocks);
+
+	parallel_for(pool, 0, blocks, 1, [&](size_t block) {
+		size_t begin = block * block_size;
+		size_t end = (begin + block_size < count) ? begin + block_size : count;
+
+		partials[block].valid = (begin < end);
+		if (begin < end)
+		{
+			partials[block].value = serial_transform_reduce<T>(first + begin, end - begin, reduce_op, transform_op);
+		}
+	});
+
+	tree_combine(partials, reduce_op);
+	return reduce_op(init, partials[0].value);
+}
+
+/**
+ * reduce elements of [first, last) using the WorkerThreads of pool
+ * - reduce_op has to be associative and commutative
+ * @return init reduced with all elements
+ */
+template <typename T, typename It, typename BinaryOp>
+T parallel_reduce(ThreadPool *pool, It first, It last, T init, BinaryOp reduce_op)
+{
+	typedef typename std::iterator_traits<It>::value_type value_type;
+
+	return parallel_transform_reduce(pool, first, last, init, reduce_op,
+			[](const value_type &value) -> T { return value; });
+}
+
+/**
+ * prefix scan of [first, last) into d_first using the WorkerThreads of pool
+ * - pass 1: reduce each block, pass 2: scan block results, pass 3: scan each block with offset
+ * - op has to be associative
+ * @param inclusive	true: d_first[i] = x0 op ... op xi, false: d_first[i] = init op x0 op ... op x(i-1)
+ */
+template <typename T, typename It, typename OutIt, typename BinaryOp>
+OutIt parallel_scan(ThreadPool *pool, It first, It last, OutIt d_first, T init, bool has_init, bool inclusive,
+		BinaryOp op)
+{
+	size_t count = std::distance(first, last);
+
+	if (count == 0)
+	{
+		return d_first;
+	}
+
+	size_t blocks = parallel_block_count(pool, count);
+	size_t block_size = (count + blocks - 1) / blocks;
+	PartialList<T> partials(blocks);
+
+	// pass 1: sum of each block (last block not needed)
+	parallel_for(pool, 0, blocks - 1, 1, [&](size_t block) {
+		size_t begin = block * block_size;
+		size_t end = (begin + block_size < count) ? begin + block_size : count;
+
+		partials[block].valid = (begin < end);
+		if (begin < end)
+		{
+			partials[block].value = serial_transform_reduce<T>(first + begin, end - begin, op,
+					[](const T &value) -> T { return value; });
+		}
+	});
+
+	// pass 2: exclusive scan of block sums -> start value of each block
+	T carry = init;
+	bool carry_valid = has_init;
+	for (size_t block = 0; block < blocks; block++)
+	{
+		T block_sum = partials[block].value;
+		bool block_valid = partials[block].valid;
+
+		partials[block].value = carry;
+		partials[block].valid = carry_valid;
+		if (block_valid)
+		{
+			carry = carry_valid ? op(carry, block_sum) : block_sum;
+			carry_valid = true;
+		}
+	}
+
+	// pass 3: scan of each block with start value
+	parallel_for(pool, 0, blocks, 1, [&](size_t block) {
+		size_t begin = block * block_size;
+		size_t end = (begin + block_size < count) ? begin + block_size : count;
+		T acc = partials[block].value;
+		bool acc_valid = partials[block].valid;
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (inclusive)
+			{
+				acc = acc_valid ? op(acc, first[i]) : T(first[i]);
+				acc_valid = true;
+				d_first[i] = acc;
+			}
+			else
+			{
+				T value = first[i];
+				d_first[i] = acc;
+				acc = op(acc, value);
+			}
+		}
+	});
+
+	return d_first + count;
+}
+
+/**
+ * inclusive prefix scan: d_first[i] = x0 op ... op xi
+ * @return iterator behind last written element
+ */
+template <typename It, typename OutIt, typename BinaryOp>
+OutIt parallel_inclusive_scan(ThreadPool *pool, It first, It last, OutIt d_first, BinaryOp op)
+{
+	typedef typename std::iterator_traits<It>::value_type value_type;
+
+	return parallel_scan(pool, first, last, d_first, value_type(), false, true, op);
+}
+
+/**
+ * exclusive prefix scan: d_first[0] = init, d_first[i] = init op x0 op ... op x(i-1)
+ * @return iterator behind last written element
+ */
+template <typename T, typename It, typename OutIt, typename BinaryOp>
+OutIt parallel_exclusive_scan(ThreadPool *pool, It first, It last, OutIt d_first, T init, BinaryOp op)
+{
+	return parallel_scan(pool, first, last, d_first, init, true, false, op);
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* PARALLELREDUCE_H_ */
@@ -0,0 +1,241 @@
+/**
+ * @file   Scheduler.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Queue disciplines for the shared functor queue of ThreadPool (FIFO, LIFO, priority, EDF)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <deque>
+
+//C++11
+#include <atomic>
+#include <mutex>
+
+#ifndef TP_OVERRIDE
+	#define TP_OVERRIDE override
+#endif
+
+#include "ThreadPoolInt/BasePoolInt.h"
+#include "ThreadPoolInt/SchedulerPoolInt.h"
+#include "ThreadPoolInt/PrioPoolInt.h"
+#ifndef NO_DEADLINE_TP_SUPPORT
+	#include "ThreadPoolInt/DeadlinePoolInt.h"
+#endif
+
+/**
+ * default count of shards of ShardedScheduler
+ */
+#ifndef TP_SHARD_COUNT
+	#define TP_SHARD_COUNT	4
+#endif
+
+/**
+ * maximum count of queued functors scanned for a reserved lane functor
+ * (aged or added low priority functors may be queued before it)
+ */
+#ifndef TP_RESERVED_SCAN
+	#define TP_RESERVED_SCAN	32
+#endif
+
+/**
+ * size of cache line in bytes (padding between shards)
+ */
+#ifndef TP_CACHELINE_SIZE
+	#define TP_CACHELINE_SIZE	64
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Queued functor with its arrival sequence (handling order may differ from arrival order)
+struct SchedulerEntry {
+	SchedulerEntry(FunctorInt *functor, uint64_t arrival): work(functor), seq(arrival) {}
+
+	FunctorInt *work;
+	uint64_t seq;
+};
+
+///Base of disciplines using one deque (front: handled next, back: handled last)
+class DequeScheduler: public SchedulerInt {
+public:
+	DequeScheduler():m_arrival(0){};
+	virtual ~DequeScheduler(){};
+
+	virtual FunctorInt *pop(uint8_t min_priority) TP_OVERRIDE;
+	virtual FunctorInt *evict(uint8_t priority) TP_OVERRIDE;
+
+	/**
+	 * - lowest arrival sequence (linear scan, overload only)
+	 */
+	virtual FunctorInt *popOldest(void) TP_OVERRIDE;
+	virtual size_t size(void) TP_OVERRIDE { return m_queue.size(); }
+	virtual int getPos(FunctorInt *work) TP_OVERRIDE;
+
+protected:
+	typedef std::deque<SchedulerEntry> queue_type;
+	queue_type	m_queue;
+
+	/**
+	 * create queue entry with next arrival sequence
+	 */
+	SchedulerEntry newEntry(FunctorInt *work){ return SchedulerEntry(work, m_arrival++); }
+
+private:
+	///arrival sequence of next pushed functor
+	uint64_t	m_arrival;
+};
+
+///First in, first out (TP_SCHED_Front puts functor before queued ones)
+class FifoScheduler: public DequeScheduler {
+public:
+	virtual const char *getName(void) TP_OVERRIDE { return "fifo"; }
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) TP_OVERRIDE;
+};
+
+///Last in, first out (newest functor first, add mode ignored)
+class LifoScheduler: public DequeScheduler {
+public:
+	virtual const char *getName(void) TP_OVERRIDE { return "lifo"; }
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) TP_OVERRIDE;
+};
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+///Ordered by priority key, FIFO on equal keys, optional aging (default discipline)
+class PrioScheduler: public DequeScheduler {
+public:
+	PrioScheduler():m_aging_ms(0){};
+
+	virtual const char *getName(void) TP_OVERRIDE { return "prio"; }
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) TP_OVERRIDE;
+	virtual FunctorInt *evict(uint8_t priority) TP_OVERRIDE;
+
+	/**
+	 * - new key base -> resort queued functors once (no rescan afterwards)
+	 */
+	virtual void setAging(uint32_t step_ms) TP_OVERRIDE;
+
+private:
+	/**
+	 * get queue order key for given priority at current time
+	 * - priority minus enqueue time bucket -> does not change while queued
+	 */
+	int64_t calcKey(uint8_t priority);
+
+	///time per priority step of aging (0: no aging)
+	uint32_t	m_aging_ms;
+};
+#endif
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+///Earliest deadline first (DeadlineFunctorInt), functors without deadline behind in FIFO order
+/**
+ * In contrast to delegateDeadlineFunctor no expiry handling: functors are only ordered.
+ */
+class EdfScheduler: public DequeScheduler {
+public:
+	virtual const char *getName(void) TP_OVERRIDE { return "edf"; }
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) TP_OVERRIDE;
+};
+#endif
+
+///Independently locked shards (concurrent: no pool lock for producers and workers)
+/**
+ * Producers add to the shorter of two random shards (power of two choices), WorkerThreads take from their
+ * home shard (worker index modulo shard count) first, then scan the others. Functors are handled in FIFO
+ * order per shard only (approximate FIFO), priorities are only used by reserved lanes and eviction.
+ * Mailboxes, deadline and tenant queues of the pool are served first while they are not empty.
+ */
+class ShardedScheduler: public SchedulerInt {
+public:
+	/**
+	 * @param shard_count	count of shards (0: TP_SHARD_COUNT)
+	 */
+	explicit ShardedScheduler(size_t shard_count = TP_SHARD_COUNT);
+	virtual ~ShardedScheduler();
+
+	virtual const char *getName(void) TP_OVERRIDE { return "sharded"; }
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) TP_OVERRIDE;
+	virtual FunctorInt *pop(uint8_t min_priority) TP_OVERRIDE { return popHome(min_priority, 0); }
+	virtual FunctorInt *popHome(uint8_t min_priority, size_t home) TP_OVERRIDE;
+	virtual FunctorInt *evict(uint8_t priority) TP_OVERRIDE;
+	virtual size_t size(void) TP_OVERRIDE { return m_count.load(std::memory_order_seq_cst); }
+
+	/**
+	 * - popOldest (default): front of a shard (approximate FIFO order)
+	 * - position within shard of functor (approximate handling order)
+	 */
+	virtual int getPos(FunctorInt *work) TP_OVERRIDE;
+	virtual bool isConcurrent(void) TP_OVERRIDE { return true; }
+
+	size_t getShardCount(void){ return m_shard_count; }
+
+	/**
+	 * get count of functors queued within given shard
+	 */
+	size_t getShardSize(size_t shard){ return (shard < m_shard_count) ? p_shards[shard].count.load() : 0; }
+
+private:
+	ShardedScheduler(const ShardedScheduler &);
+	ShardedScheduler &operator=(const ShardedScheduler &);
+
+	///one shard, padded by a full cache line (no false sharing between shards)
+	struct Shard {
+		Shard():count(0){};
+
+		std::mutex lock;
+		std::deque<FunctorInt *> queue;	// locked by lock
+		std::atomic<size_t> count;	// read without lock
+		char pad[TP_CACHELINE_SIZE];
+	};
+
+	/**
+	 * take functor from given shard
+	 * @return NULL if shard is empty or no scanned functor reaches min_priority
+	 */
+	FunctorInt *popShard(Shard &shard, uint8_t min_priority);
+
+	size_t		m_shard_count;
+	Shard		*p_shards;
+
+	///count of functors of all shards
+	std::atomic<size_t>	m_count;
+};
+
+/**
+ * create scheduler by name (e.g. from configuration)
+ * @param name	"fifo", "lifo", "prio", "edf", "sharded" or NULL for default discipline
+ * @return new object (owned by caller until passed to pool) or NULL for unknown/unsupported name
+ */
+SchedulerInt *createScheduler(const char *name = NULL);
+
+/**
+ * get name of available discipline
+ * @return NULL if index is out of range
+ */
+const char *getSchedulerName(size_t index);
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* SCHEDULER_H_ */
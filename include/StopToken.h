@@ -0,0 +1,208 @@
+/**
+ * @file   StopToken.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Cooperative cancellation of functors (stop source, token and callback)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef STOPTOKEN_H_
+#define STOPTOKEN_H_
+
+#include <icke2063_TP_config.h>
+
+#include <pthread.h>
+
+//C++11
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <list>
+
+#include "ThreadPoolInt/BasePoolInt.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+class StopCallback;
+
+///Shared state of StopSource, StopToken and StopCallback
+class StopState {
+	friend class StopSource;
+	friend class StopCallback;
+public:
+	StopState();
+
+	/**
+	 * - remove link to parent token
+	 */
+	~StopState();
+
+	bool stopRequested(void){ return m_stop_requested.load(std::memory_order_acquire); }
+
+	/**
+	 * set stop flag, call registered callbacks within calling thread
+	 * @return false if stop was requested before
+	 */
+	bool requestStop(void);
+
+private:
+	/**
+	 * register callback
+	 * @return false if stop was requested before (not registered)
+	 */
+	bool addCallback(StopCallback *callback);
+
+	/**
+	 * deregister callback, wait for its end if it is called by another thread
+	 */
+	void removeCallback(StopCallback *callback);
+
+	///stop flag (polled by functors)
+	std::atomic<bool> m_stop_requested;
+
+	///lock callback list
+	std::mutex m_lock;
+
+	///registered callbacks (locked by m_lock)
+	std::list<StopCallback*> m_callbacks;
+
+	///callback called by requestStop (locked by m_lock)
+	StopCallback *p_running;
+
+	///thread calling the callbacks
+	pthread_t m_running_thread;
+
+	///callback registered at parent token (linked source)
+	StopCallback *p_link;
+};
+
+///Read access to stop state (cheap copy, polled by functors)
+class StopToken {
+	friend class StopCallback;
+public:
+	/**
+	 * token without state (stop is never requested)
+	 */
+	StopToken(){};
+	explicit StopToken(const std::shared_ptr<StopState> &state):sp_state(state){};
+
+	bool stopRequested(void) const { return sp_state && sp_state->stopRequested(); }
+
+	/**
+	 * check if token is bound to a StopSource
+	 */
+	bool stopPossible(void) const { return sp_state.get() != NULL; }
+
+private:
+	std::shared_ptr<StopState> sp_state;
+};
+
+///Owner of stop state
+class StopSource {
+public:
+	StopSource();
+
+	/**
+	 * linked source: stop is requested also when parent token is stopped
+	 */
+	explicit StopSource(const StopToken &parent);
+
+	/**
+	 * request stop, call registered callbacks within calling thread
+	 * @return false if stop was requested before
+	 */
+	bool requestStop(void){ return sp_state->requestStop(); }
+
+	bool stopRequested(void){ return sp_state->stopRequested(); }
+
+	StopToken getToken(void){ return StopToken(sp_state); }
+
+	/**
+	 * check if tokens or callbacks of this source exist (otherwise nobody can see a stop request)
+	 */
+	bool hasTokens(void){ return sp_state.use_count() > 1; }
+
+private:
+	std::shared_ptr<StopState> sp_state;
+};
+
+///Callback on stop request (RAII registration)
+/**
+ * The functor_function of the callback functor is called once by the thread requesting the stop,
+ * or within the constructor if stop was requested before. The destructor deregisters the callback
+ * (waits if it is called meanwhile by another thread) and releases the callback functor.
+ */
+class StopCallback {
+	friend class StopState;
+public:
+	/**
+	 * @param token		token to watch (no state: callback is never called)
+	 * @param callback	functor called on stop request (released by destructor)
+	 */
+	StopCallback(const StopToken &token, FunctorInt *callback);
+	~StopCallback();
+
+private:
+	StopCallback(const StopCallback &);
+	StopCallback &operator=(const StopCallback &);
+
+	std::shared_ptr<StopState> sp_state;
+	FunctorInt *p_callback;
+
+	///callback function finished (no access to object by requesting thread afterwards)
+	std::atomic<bool> m_done;
+};
+
+///Functor extension for cooperative cancellation
+/**
+ * Long running functors poll stopRequested() (one atomic load) or register a StopCallback on
+ * getStopToken() and return early. Without own token the token of the ThreadPool executing the
+ * functor is used (stopped by shutdown). TaskGroup and deadline handling bind linked tokens.
+ */
+class StopFunctorInt {
+public:
+	StopFunctorInt(){};
+	virtual ~StopFunctorInt(){};
+
+	/**
+	 * bind token (replaces pool token)
+	 */
+	void setStopToken(const StopToken &token){m_stop_token = token;}
+
+	/**
+	 * check if a token is bound (set or taken from executing pool)
+	 */
+	bool hasStopToken(void){return m_stop_token.stopPossible();}
+
+	/**
+	 * get bound token or token of ThreadPool of calling WorkerThread
+	 */
+	StopToken getStopToken(void);
+
+	bool stopRequested(void){
+		return m_stop_token.stopPossible() ? m_stop_token.stopRequested() : getStopToken().stopRequested();
+	}
+
+private:
+	StopToken m_stop_token;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* STOPTOKEN_H_ */
@@ -0,0 +1,147 @@
+/**
+ * @file   Strand.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Serial executor on top of ThreadPool (ordered execution per strand)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef STRAND_H_
+#define STRAND_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+
+//C++11
+#include <atomic>
+
+//common_cpp
+#include <ThreadPool.h>
+#include "CompletionEvent.h"
+#include "MpscQueue.h"
+
+//logging macros
+#ifndef Strand_log_debug
+	#define Strand_log_debug(...)
+#endif
+
+#ifndef Strand_log_error
+	#define Strand_log_error(...)
+#endif
+
+/**
+ * maximum count of functors handled per turn of a strand (then it is queued again)
+ */
+#ifndef TP_STRAND_BATCH
+	#define TP_STRAND_BATCH	64
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Node of strand queue
+struct StrandNode {
+	std::atomic<StrandNode*> next;
+	FunctorInt *functor;
+};
+
+///Serial executor: functors of one strand are handled one after another in FIFO order
+/**
+ * Functors posted to a strand are stored within a lock-free multi producer/single consumer queue
+ * (intrusive Vyukov queue). The strand delegates itself as functor to the pool when the first functor
+ * is posted. The worker handling it drains up to TP_STRAND_BATCH functors and delegates the strand again
+ * if more are queued. So a strand never occupies more than one worker and no worker waits for a strand.
+ *
+ * A strand is a small object without thread or lock -> use as many strands as needed (e.g. one per session).
+ * The strand object has to stay alive until all posted functors are handled (the destructor waits for it)
+ * -> delete strands before their pool. If the pool releases the queued strand unhandled (overload, clearQueue,
+ * shutdown) all posted functors are released unhandled too.
+ */
+class Strand: public Functor {
+public:
+	Strand(ThreadPool *pool);
+
+	/**
+	 * - wait until all posted functors are handled
+	 */
+	virtual ~Strand();
+
+	/**
+	 * Post new functor to strand
+	 * @param work:	pointer to FunctorInt Object (will be released after use)
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+	FunctorInt *post(FunctorInt *work);
+
+	/**
+	 * get count of posted but not handled functors
+	 */
+	int32_t getPendingCount(void){ return m_count.load(std::memory_order_acquire); }
+
+	/**
+	 * check if calling thread currently handles a functor of this strand
+	 */
+	bool isCurrent(void){ return p_current_strand == this; }
+
+	/**
+	 * handle queued functors (called by WorkerThread)
+	 */
+	virtual void functor_function(void) TP_OVERRIDE;
+
+	/**
+	 * released unhandled by pool -> release queued functors (strand is owned by user)
+	 */
+	virtual void functor_release(void) TP_OVERRIDE;
+
+	/**
+	 * only handle queued functors (strand may be queued again or deleted afterwards)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE { functor_function(); }
+
+private:
+	/**
+	 * delegate strand to pool (handle it within calling thread on failure)
+	 */
+	void schedule(void);
+
+	/**
+	 * count handled/released functor, wakeup destructor if none is pending anymore
+	 * @return true if queue is empty (strand not queued anymore)
+	 */
+	bool countDone(void);
+
+	ThreadPool *p_pool;
+
+	///posted functors (consumer: worker handling the strand)
+	MpscQueue<StrandNode> m_queue;
+
+	///count of posted but not handled functors (0 -> strand not queued)
+	std::atomic<int32_t> m_count;
+
+	///signaled when m_count drops to 0 (destructor waits for it)
+	CompletionEvent m_done;
+
+	///strand handled by calling thread
+	static thread_local Strand *p_current_strand;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* STRAND_H_ */
@@ -0,0 +1,218 @@
+/**
+ * @file   TaskGraph.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Dependency graph (DAG) of functors scheduled on a ThreadPool
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef TASKGRAPH_H_
+#define TASKGRAPH_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+
+//C++11
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+//common_cpp
+#include <ThreadPool.h>
+#include "CompletionEvent.h"
+
+//logging macros
+#ifndef TaskGraph_log_debug
+	#define TaskGraph_log_debug(...)
+#endif
+
+#ifndef TaskGraph_log_error
+	#define TaskGraph_log_error(...)
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+class TaskGraph;
+
+///Node of TaskGraph
+/**
+ * Reusable functor object owned by the TaskGraph (not deleted by ThreadPool).
+ * After calling the stored functor the dependency counters of all successors
+ * are decremented. The first ready successor is handled directly by the same
+ * WorkerThread (cache locality), all other ready successors are delegated to the pool.
+ * A node released unhandled by the pool (overload, clearQueue, shutdown) is cancelled
+ * together with all nodes depending on it -> the run completes anyway.
+ */
+class GraphNode: public Functor {
+	friend class TaskGraph;
+public:
+	GraphNode(TaskGraph *graph, FunctorInt *functor);
+
+	/**
+	 * - delete stored functor
+	 */
+	virtual ~GraphNode();
+
+	virtual void functor_function(void) TP_OVERRIDE;
+
+	/**
+	 * owned by TaskGraph -> no release after handling (graph may be deleted after last node)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE { functor_function(); }
+
+	/**
+	 * released unhandled by pool -> cancel node and its successors
+	 */
+	virtual void functor_release(void) TP_OVERRIDE { cancel(); }
+
+private:
+	/**
+	 * complete node without calling stored functor, cancel successors
+	 */
+	void cancel(void);
+
+	TaskGraph *p_graph;
+	FunctorInt *p_functor;
+
+	///successor nodes
+	std::vector<GraphNode*> m_successors;
+
+	///count of predecessor nodes
+	int32_t m_pred_count;
+
+	///count of predecessors not completed within current run
+	std::atomic<int32_t> m_pending_preds;
+
+	///a predecessor was cancelled within current run
+	std::atomic<bool> m_cancelled;
+
+	///visit mark of isReachable (== TaskGraph::m_visit_epoch: already visited)
+	uint32_t m_visit_epoch;
+};
+
+///Dependency graph of functors
+/**
+ * Build the graph once with addNode/addEdge and run it with submit as often as needed.
+ * Each run only resets the dependency counters -> no allocation after building the graph.
+ * Nodes without predecessors are delegated on submit, all other nodes are started
+ * as soon as their last predecessor is completed.
+ *
+ * The graph has to stay alive until the current run is completed (the destructor waits for it).
+ */
+class TaskGraph {
+	friend class GraphNode;
+public:
+	typedef uint32_t node_id;
+
+	TaskGraph(ThreadPool *pool);
+
+	/**
+	 * - wait for current run
+	 * - delete all nodes and stored functors
+	 */
+	virtual ~TaskGraph();
+
+	/**
+	 * add new node
+	 * @param functor	functor object (owned by graph, functor_function is called on each run)
+	 * @return id of new node
+	 */
+	node_id addNode(FunctorInt *functor);
+
+	/**
+	 * add dependency: node succ is started after node pred is completed
+	 * @return false on invalid id, running graph or if edge would create a cycle
+	 */
+	bool addEdge(node_id pred, node_id succ);
+
+	/**
+	 * start new run of graph
+	 * @return false if graph is empty or still running
+	 */
+	bool submit(void);
+
+	/**
+	 * wait until current run is completed
+	 * - WorkerThread of pool handles queued functors meanwhile
+	 * @param timeout_ms	maximum time to wait (<0: wait forever)
+	 * @return true if completed, false on timeout
+	 */
+	bool wait(int32_t timeout_ms = -1);
+
+	/**
+	 * check if graph is running
+	 */
+	bool isRunning(void){ return m_remaining.load(std::memory_order_acquire) > 0; }
+
+	/**
+	 * get count of nodes
+	 */
+	size_t getNodeCount(void){ return m_nodes.size(); }
+
+	/**
+	 * get count of nodes cancelled within last run (released by pool or depending on such one)
+	 */
+	int32_t getCancelledCount(void){ return m_cancelled_count.load(std::memory_order_acquire); }
+
+protected:
+	/**
+	 * delegate ready node to pool (handled by calling thread on failure)
+	 */
+	void delegateNode(GraphNode *node);
+
+	/**
+	 * called on completion of node
+	 */
+	void nodeDone(void);
+
+	/**
+	 * check if succ is reachable from start node
+	 * - each node is visited once (epoch mark) -> linear in graph size
+	 * - m_graph_lock has to be locked by caller
+	 */
+	bool isReachable(GraphNode *start, GraphNode *succ);
+
+	ThreadPool *p_pool;
+
+	///list of nodes (index = node_id)
+	std::vector<GraphNode*> m_nodes;
+
+	///list of nodes without predecessor
+	std::vector<GraphNode*> m_roots;
+
+	///lock for graph building and submit
+	std::mutex m_graph_lock;
+
+	///current visit mark of isReachable (locked by m_graph_lock)
+	uint32_t m_visit_epoch;
+
+	///count of not completed nodes within current run
+	std::atomic<int32_t> m_remaining;
+
+	///signaled on completion of run
+	CompletionEvent m_done;
+
+	///count of cancelled nodes within current run
+	std::atomic<int32_t> m_cancelled_count;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* TASKGRAPH_H_ */
@@ -0,0 +1,174 @@
+/**
+ * @file   TaskGroup.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Group of functors delegated to a ThreadPool with blocking wait for completion
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef TASKGROUP_H_
+#define TASKGROUP_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+
+//C++11
+#include <atomic>
+
+//common_cpp
+#include <ThreadPool.h>
+#include "CompletionEvent.h"
+
+//logging macros
+#ifndef TaskGroup_log_debug
+	#define TaskGroup_log_debug(...)
+#endif
+
+#ifndef TaskGroup_log_error
+	#define TaskGroup_log_error(...)
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+class TaskGroup;
+
+///Functor wrapper used by TaskGroup
+/**
+ * Calls the functor_function of the wrapped functor (skipped if the group is cancelled). The destructor
+ * deletes the wrapped functor and signals the completion to the TaskGroup (also if removed unhandled from queue).
+ */
+class GroupFunctor: public Functor {
+	friend class TaskGroup;
+public:
+	GroupFunctor(TaskGroup *group, FunctorInt *functor);
+	virtual ~GroupFunctor();
+
+	virtual void functor_function(void) TP_OVERRIDE;
+
+private:
+	TaskGroup *p_group;
+	FunctorInt *p_functor;
+};
+
+///Group of functors with wait for all or any completion
+/**
+ * Functors are delegated through the group to the ThreadPool. The completion of each functor
+ * is counted atomically. Waiting threads are parked on a futex (no polling).
+ * If the waiting thread is a WorkerThread of the pool it handles queued functors meanwhile
+ * instead of blocking its worker slot.
+ *
+ * The group object has to stay alive until all delegated functors are completed
+ * (the destructor waits for it).
+ */
+class TaskGroup {
+	friend class GroupFunctor;
+public:
+	TaskGroup(ThreadPool *pool);
+
+	/**
+	 * - wait for completion of all delegated functors
+	 */
+	virtual ~TaskGroup();
+
+	/**
+	 * Delegate new functor to pool as member of this group
+	 * @param work:	pointer to FunctorInt Object (will be deleted after use)
+	 * @param add_mode:	add mode of ThreadPool::delegateFunctor
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *delegateFunctor(FunctorInt *work, uint8_t add_mode = TPI_ADD_Default);
+#else
+	FunctorInt *delegateFunctor(FunctorInt *work);
+#endif
+
+	/**
+	 * wait until all delegated functors are completed
+	 * @param timeout_ms	maximum time to wait (<0: wait forever)
+	 * @return true if all functors are completed, false on timeout
+	 */
+	bool waitAll(int32_t timeout_ms = -1);
+
+	/**
+	 * wait until any delegated functor is completed
+	 * - each completion is reported once -> call it n times to get n completions
+	 * @param timeout_ms	maximum time to wait (<0: wait forever)
+	 * @return true if an unreported completion was taken, false on timeout or nothing pending
+	 */
+	bool waitAny(int32_t timeout_ms = -1);
+
+	/**
+	 * get count of delegated but not completed functors
+	 */
+	int32_t getPendingCount(void){ return m_pending.load(std::memory_order_acquire); }
+
+	/**
+	 * get count of completed functors not reported by waitAny
+	 */
+	int32_t getCompletedCount(void){ return m_completed.load(std::memory_order_acquire); }
+
+	/**
+	 * register functor which signals its completion itself (no GroupFunctor wrapper)
+	 * - has to be called before delegating the functor
+	 * - each call has to be followed by exactly one functorDone call
+	 */
+	void addPending(void){ m_pending.fetch_add(1, std::memory_order_acq_rel); }
+
+	/**
+	 * called on completion of group functor
+	 */
+	void functorDone(void);
+
+	/**
+	 * cancel group: request stop of group token
+	 * - queued functors are completed without handling
+	 * - running StopFunctorInt functors see stopRequested()
+	 * - new functors are refused
+	 * - also triggered by shutdown of the pool (linked token)
+	 */
+	void cancel(void){ m_stop_source.requestStop(); }
+
+	bool isCancelled(void){ return m_stop_source.stopRequested(); }
+
+	/**
+	 * get stop token of group (bound to delegated StopFunctorInt functors without own token)
+	 */
+	StopToken getStopToken(void){ return m_stop_source.getToken(); }
+
+protected:
+	ThreadPool *p_pool;
+
+	///count of delegated but not completed functors
+	std::atomic<int32_t> m_pending;
+
+	///count of completed functors not reported by waitAny
+	std::atomic<int32_t> m_completed;
+
+	///signaled on each completion
+	CompletionEvent m_done;
+
+	///cancellation of group (linked to stop token of pool)
+	StopSource m_stop_source;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+#endif /* TASKGROUP_H_ */
@@ -29,11 +29,18 @@
 
 #include <sys/time.h>
 #include <pthread.h>
+#include <sched.h>
 
 
 //C++11
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <map>
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
 
 #ifndef TP_OVERRIDE
 	#define TP_OVERRIDE override
@@ -48,11 +55,39 @@
 	#include "ThreadPoolInt/DynamicPoolInt.h"
 #endif
 #include "ThreadPoolInt/PrioPoolInt.h"
+#include "ThreadPoolInt/OverloadPoolInt.h"
+#include "ThreadPoolInt/ShutdownPoolInt.h"
+#ifndef NO_DEADLINE_TP_SUPPORT
+	#include "ThreadPoolInt/DeadlinePoolInt.h"
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+	#include "ThreadPoolInt/TenantPoolInt.h"
+#endif
+#include "ThreadPoolInt/RatePoolInt.h"
+#ifndef NO_REACTOR_TP_SUPPORT
+	#include "ThreadPoolInt/ReactorPoolInt.h"
+#endif
+#include "StopToken.h"
+#include "Scheduler.h"
 
 #ifndef DEFAULT_TP_MAINLOOP_IDLE_US
 	#define DEFAULT_TP_MAINLOOP_IDLE_US 1000
 #endif
 
+/**
+ * default limit of functors within a worker mailbox (more -> shared functor queue)
+ */
+#ifndef TP_MAILBOX_MAX
+	#define TP_MAILBOX_MAX	32
+#endif
+
+/**
+ * default mailbox size from which other workers steal functors (0: no stealing)
+ */
+#ifndef TP_MAILBOX_STEAL
+	#define TP_MAILBOX_STEAL	8
+#endif
+
 //logging macros
 #ifndef ThreadPool_log_trace
 	#define ThreadPool_log_trace(...)
@@ -73,6 +108,11 @@
 namespace icke2063 {
 namespace threadpool {
 
+class WorkerThread;
+#ifdef TP_COROUTINE_SUPPORT
+class ScheduleAwaiter;
+#endif
+
 class Functor:
 	public FunctorInt
 #ifndef NO_PRIORITY_TP_SUPPORT
@@ -85,6 +125,55 @@ public:
 
 };
 
+#ifndef NO_DEADLINE_TP_SUPPORT
+///Functor with completion deadline (earliest-deadline-first queue)
+class DeadlineFunctor:
+	public Functor,
+	public DeadlineFunctorInt
+	{
+public:
+	DeadlineFunctor(){};
+	virtual ~DeadlineFunctor(){};
+};
+#endif
+
+///Functor with cooperative cancellation (poll stopRequested)
+class StopFunctor:
+	public Functor,
+	public StopFunctorInt
+	{
+public:
+	StopFunctor(){};
+	virtual ~StopFunctor(){};
+};
+
+#ifndef NO_REACTOR_TP_SUPPORT
+///Handler functor for ready file descriptors (ThreadPool::registerFd)
+/**
+ * implement io_ready, object is owned by caller (not released by pool)
+ */
+class IoFunctor:
+	public Functor,
+	public IoFunctorInt
+	{
+public:
+	IoFunctor(){};
+	virtual ~IoFunctor(){};
+
+	virtual void functor_function(void) TP_OVERRIDE { dispatchReady(); }
+
+	/**
+	 * released unhandled by pool -> drop collected events (handler is not pending anymore)
+	 */
+	virtual void functor_release(void) TP_OVERRIDE { cancelReady(); }
+
+	/**
+	 * only handle events (handler may be deleted afterwards)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE { functor_function(); }
+};
+#endif
+
 #ifndef NO_DELAYED_TP_SUPPORT
 ///Implementations for DelayedFunctorInt
 class DelayedFunctor: public DelayedFunctorInt {
@@ -116,6 +205,152 @@ private:
 };
 #endif
 
+#ifndef NO_DEADLINE_TP_SUPPORT
+/**
+ * minimum count of deadline stops before finished ones are pruned
+ */
+#ifndef DEADLINE_STOPS_PRUNE_MIN
+	#define DEADLINE_STOPS_PRUNE_MIN	64
+#endif
+#endif
+
+/**
+ * count of priority levels for queue position tracking
+ */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	#define TP_QUEUE_LEVELS	101
+#else
+	#define TP_QUEUE_LEVELS	1
+#endif
+
+///Position ticket of a delegated functor
+/**
+ * Sequence number of the functor within its priority level at insertion.
+ * Queue position and start state are derived from per level enqueue/dequeue counters
+ * without queue lock or queue walk.
+ */
+struct QueueTicket {
+	QueueTicket(): level(0), seq(0), evicted(0), valid(false) {}
+
+	uint8_t level;		///< priority level at insertion
+	uint64_t seq;		///< sequence number within level
+	uint64_t evicted;	///< evicted functors of level before insertion (gaps before seq)
+	bool valid;		///< false: functor not queued (e.g. handled by caller)
+};
+
+///Creation attributes for WorkerThread objects
+/**
+ * Collection of pthread attributes used for each new WorkerThread of a ThreadPool.
+ * Unset values keep the system defaults (same as pthread_create with NULL attributes).
+ * - cpu affinity for all workers or for a single worker index
+ * - stack size
+ * - scheduling policy (SCHED_*) and priority
+ * - thread name prefix ("<prefix>-<worker index>")
+ */
+class WorkerAttr {
+public:
+	WorkerAttr():
+		m_stack_size(0),
+		m_sched_policy(-1),
+		m_sched_priority(0),
+		m_affinity_set(false)
+	{
+		CPU_ZERO(&m_affinity);
+	}
+
+	/**
+	 * set cpu affinity mask for all workers
+	 */
+	void setAffinity(const cpu_set_t &cpuset){m_affinity = cpuset; m_affinity_set = true;}
+
+	/**
+	 * add single cpu to affinity mask for all workers
+	 */
+	void addAffinityCpu(int cpu){
+		if(!m_affinity_set){CPU_ZERO(&m_affinity);}
+		CPU_SET(cpu, &m_affinity);
+		m_affinity_set = true;
+	}
+
+	/**
+	 * set cpu affinity mask for worker with given index
+	 * - overrides pool wide mask for this worker
+	 */
+	void setWorkerAffinity(uint16_t worker_index, const cpu_set_t &cpuset){
+		m_worker_affinity[worker_index] = cpuset;
+	}
+
+	/**
+	 * remove all affinity settings -> inherit from creating thread
+	 */
+	void clearAffinity(void){
+		CPU_ZERO(&m_affinity);
+		m_affinity_set = false;
+		m_worker_affinity.clear();
+	}
+
+	/**
+	 * get affinity mask for given worker index
+	 * @return NULL if no affinity set
+	 */
+	const cpu_set_t *getAffinity(uint16_t worker_index) const;
+
+	/**
+	 * set stack size of each worker thread
+	 * @param stack_size	size in bytes (0: system default)
+	 */
+	void setStackSize(size_t stack_size){m_stack_size = stack_size;}
+	size_t getStackSize(void) const {return m_stack_size;}
+
+	/**
+	 * set scheduling policy of worker threads
+	 * @param policy	SCHED_OTHER, SCHED_BATCH, SCHED_IDLE, SCHED_FIFO, SCHED_RR (-1: inherit)
+	 * @param priority	static priority (only used by SCHED_FIFO/SCHED_RR)
+	 */
+	void setSchedPolicy(int policy, int priority = 0){
+		m_sched_policy = policy;
+		m_sched_priority = priority;
+	}
+	int getSchedPolicy(void) const {return m_sched_policy;}
+	int getSchedPriority(void) const {return m_sched_priority;}
+
+	/**
+	 * set name prefix of worker threads
+	 * - thread name is "<prefix>-<worker index>" (truncated to 15 characters)
+	 */
+	void setName(const std::string &name){m_name = name;}
+	const std::string &getName(void) const {return m_name;}
+
+	/**
+	 * build thread name for given worker index
+	 * @return empty string if no name set
+	 */
+	std::string getThreadName(uint16_t worker_index) const;
+
+	/**
+	 * initialize pthread attribute object with the stored values
+	 * - on success attr has to be destroyed by caller (pthread_attr_destroy)
+	 * - on failure attr is not initialized (already destroyed)
+	 * @return 0 on success, else error number of failing pthread_attr_* call
+	 */
+	int initPthreadAttr(pthread_attr_t *attr, uint16_t worker_index) const;
+
+	/**
+	 * apply changeable attributes (affinity, scheduling, name) to running thread
+	 * @return 0 on success, else error number of failing pthread_* call
+	 */
+	int applyToThread(pthread_t thread, uint16_t worker_index) const;
+
+private:
+	size_t m_stack_size;
+	int m_sched_policy;
+	int m_sched_priority;
+	bool m_affinity_set;
+	cpu_set_t m_affinity;
+	std::map<uint16_t, cpu_set_t> m_worker_affinity;
+	std::string m_name;
+};
+
 class ThreadPool:
 	public BasePoolInt
 #ifndef NO_DELAYED_TP_SUPPORT
@@ -127,6 +362,20 @@ class ThreadPool:
 #ifndef NO_PRIORITY_TP_SUPPORT
 	,public PrioThreadPoolInt
 #endif
+#ifndef NO_DEADLINE_TP_SUPPORT
+	,public DeadlinePoolInt
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+	,public TenantPoolInt
+#endif
+#ifndef NO_RATE_TP_SUPPORT
+	,public RatePoolInt
+#endif
+#ifndef NO_REACTOR_TP_SUPPORT
+	,public ReactorPoolInt
+#endif
+	,public OverloadPoolInt
+	,public ShutdownPoolInt
 	{
 
 	friend class WorkerThread;
@@ -138,9 +387,17 @@ class ThreadPool:
 #define TPI_ADD_Default	0
 #define TPI_ADD_FiFo	1
 #define TPI_ADD_LiFo	2
+#define TPI_ADD_Deadline	3
 
 public:
-	ThreadPool(uint8_t worker_count = 1, bool auto_start = true);
+	/**
+	 * @param worker_count	count of initial WorkerThreads
+	 * @param auto_start	start pool loop within constructor
+	 * @param worker_attr	creation attributes for WorkerThreads (NULL: system defaults)
+	 * @param scheduler	queue discipline of functor queue, deleted by pool (NULL: createScheduler())
+	 */
+	ThreadPool(uint8_t worker_count = 1, bool auto_start = true, const WorkerAttr *worker_attr = NULL,
+			SchedulerInt *scheduler = NULL);
 	virtual ~ThreadPool();
 
 	/**
@@ -149,6 +406,19 @@ public:
 	 */
 	void setTPMainLoopIdleTime(uint32_t main_idle_us);
 
+	/**
+	 * Set creation attributes for WorkerThreads
+	 * - used for all new workers (also for dynamically added ones)
+	 * - affinity, scheduling and name are applied to running workers too
+	 * @return true if all running workers could be updated
+	 */
+	bool setWorkerAttr(const WorkerAttr &worker_attr);
+
+	/**
+	 * get copy of current WorkerThread creation attributes
+	 */
+	WorkerAttr getWorkerAttr(void);
+
 	///Implementations for BasePoolInt
 	/**
 	 * Add new functor object
@@ -165,12 +435,183 @@ public:
 	virtual FunctorInt *delegateFunctor(FunctorInt *work) TP_OVERRIDE;
 #endif
 
+	/**
+	 * - read with locked worker list (changed by dynamic handling and blocking sections)
+	 * - not callable with locked m_worker_lock
+	 */
+	virtual size_t getWorkerCount(void) TP_OVERRIDE;
+
+	/**
+	 * Add new functor object, wait for free queue space if the functor queue is full
+	 * - producer is parked on a condition (no busy retry) and woken when WorkerThreads drain the queue
+	 * @param work		pointer to functor object
+	 * @param timeout_ms	maximum time to wait for free queue space (<0: wait forever)
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (timeout, pool stopped or not addable)
+	 */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *delegateFunctorWait(FunctorInt *work, int32_t timeout_ms = -1, uint8_t add_mode = TPI_ADD_Default);
+#else
+	FunctorInt *delegateFunctorWait(FunctorInt *work, int32_t timeout_ms = -1);
+#endif
+
+	///Implementations for OverloadPoolInt
+	/**
+	 * - TP_OVERLOAD_DropOldest releases the functor queued first (SchedulerInt::popOldest, not the
+	 * 	next one to handle for priority/EDF/LIFO order)
+	 * - TP_OVERLOAD_EvictLowest compares queue order (priority, aging); without priority support it rejects
+	 * 	(SchedulerInt::evict of the queue discipline)
+	 * - not used by delegateFunctorWait (waits instead)
+	 */
+	virtual bool setOverloadPolicy(uint8_t policy, OverloadHandlerInt *handler = NULL) TP_OVERRIDE;
+	virtual uint32_t getOverloadCount(uint8_t policy) TP_OVERRIDE {
+		return (policy < TP_OVERLOAD_COUNT) ? m_overload_count[policy].load() : 0;
+	}
+	virtual uint32_t getOverloadDropCount(void) TP_OVERRIDE { return m_overload_dropped; }
+
+	///Implementations for ShutdownPoolInt
+	/**
+	 * - delegations are refused from start of shutdown (also by running functors)
+	 * - pool loop is stopped first: delayed functors which are not due are released
+	 * - drain waits until all queues (shared, mailboxes, deadline, tenant) are empty
+	 * - all WorkerThreads are signaled before joining -> shutdown time does not grow with worker count
+	 * - called by destructor with TP_SHUTDOWN_Abort (if not called before)
+	 */
+	virtual size_t shutdown(uint8_t mode = TP_SHUTDOWN_Drain, uint32_t timeout_ms = 0) TP_OVERRIDE;
+	virtual bool isShutdown(void) TP_OVERRIDE { return m_shutdown; }
+
+	/**
+	 * get stop token of pool
+	 * - stop is requested by shutdown after the queues are drained/released, before joining the workers
+	 * - used by StopFunctorInt without own token, parent of TaskGroup and deadline tokens
+	 */
+	StopToken getStopToken(void){ return m_stop_source.getToken(); }
+
 	bool isPoolLoopRunning(){return m_loop_running;}
+
+	/**
+	 * handle next queued functor within calling thread
+	 * - used by waiting threads to help the WorkerThreads
+	 * @return true if a functor was handled, false on empty queue
+	 */
+	bool runPendingFunctor(void);
+
+	/**
+	 * check if calling thread is a WorkerThread of this pool
+	 */
+	bool isWorkerThread(void);
+
+	/**
+	 * Start blocking section within a functor (managed blocking)
+	 * - calling WorkerThread is counted as blocked
+	 * - without idle worker a compensating WorkerThread is created immediately
+	 *   (up to HighWatermark, WORKERTHREAD_MAX without dynamic handling)
+	 * @return true if counted (call endBlocking afterwards), false if caller is no WorkerThread of this pool
+	 */
+	bool beginBlocking(void);
+
+	/**
+	 * End blocking section started by beginBlocking
+	 * - retire compensating worker (later by pool loop if none is idle)
+	 */
+	void endBlocking(void);
+
+	/**
+	 * get count of WorkerThreads within blocking section
+	 */
+	uint32_t getBlockedCount(void){ return m_blocked_count; }
+
+	/**
+	 * Add functor to mailbox of given worker (handled by this worker before the shared functor queue)
+	 * - reserved lane workers have no mailbox
+	 * - mailbox limit reached -> functor is delegated to shared functor queue (delegateFunctor)
+	 * @param worker_index	index of target WorkerThread
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (unknown worker, not added, not deleted)
+	 */
+	FunctorInt *delegateWorkerFunctor(FunctorInt *work, uint16_t worker_index);
+
+	/**
+	 * Add functor to mailbox of worker selected by key (jump consistent hash over normal workers)
+	 * - same key -> same worker while worker count is unchanged, minimal remapping on change
+	 * - once used, delWorker retires the normal worker with highest index only (keys of other workers keep their worker)
+	 * - see delegateWorkerFunctor
+	 */
+	FunctorInt *delegateKeyFunctor(FunctorInt *work, uint64_t key);
+
+	/**
+	 * get index of worker selected by key (-1: no worker)
+	 */
+	int getKeyWorker(uint64_t key);
+
+	/**
+	 * get index of calling WorkerThread (-1: no worker of this pool), e.g. for per worker caches
+	 */
+	int getCurrentWorkerIndex(void);
+
+	/**
+	 * set mailbox limits
+	 * @param limit		maximum count of functors within a mailbox
+	 * @param steal_min	idle workers steal from mailboxes with at least steal_min functors (0: no stealing)
+	 */
+	void setMailboxLimit(size_t limit, size_t steal_min = TP_MAILBOX_STEAL);
+
+	/**
+	 * get count of functors within mailbox of worker
+	 */
+	size_t getMailboxCount(uint16_t worker_index);
+
+	/**
+	 * get count of functors delegated to shared queue because of full mailbox
+	 */
+	uint32_t getMailboxFallbackCount(void){ return m_mailbox_fallback; }
+
+	/**
+	 * get count of functors stolen from mailboxes of other workers
+	 */
+	uint32_t getMailboxStealCount(void){ return m_mailbox_stolen; }
+
+#ifdef TP_COROUTINE_SUPPORT
+	/**
+	 * awaitable to continue calling coroutine within a WorkerThread of this pool
+	 * - co_await pool.schedule();
+	 * - no allocation per resume (awaiter is delegated as functor)
+	 */
+	ScheduleAwaiter schedule(void);
+#endif
 	/**
 	 * get queue position of given Functor reference
+	 * - walks the locked queue (exact)
 	 */
 	virtual int getQueuePos(FunctorInt *searchedFunctor);
 
+	/**
+	 * Add new functor object and get position ticket
+	 * @param work		pointer to functor object
+	 * @param ticket	position ticket of added functor
+	 * @return		see delegateFunctor
+	 */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *delegateFunctorTicket(FunctorInt *work, QueueTicket &ticket, uint8_t add_mode = TPI_ADD_Default);
+#else
+	FunctorInt *delegateFunctorTicket(FunctorInt *work, QueueTicket &ticket);
+#endif
+
+	/**
+	 * get queue position of functor by ticket (lock-free, no queue walk)
+	 * - FIFO (single priority level): exact
+	 * - priority mode: queued functors of higher levels plus own position within level (bounded by level count);
+	 *   approximation with LiFo inserts or priority aging
+	 * - not meaningful for "lifo" and "sharded" disciplines (no FIFO order of tickets)
+	 * @return position (0: next) or -1 if functor left the queue
+	 */
+	int getQueuePos(const QueueTicket &ticket);
+
+	/**
+	 * check if functor left the queue (started, or released by overload/clear)
+	 */
+	bool isStarted(const QueueTicket &ticket);
+
 #ifndef NO_DELAYED_TP_SUPPORT
 	///Implementations for DelayedPoolInt
 	virtual std::shared_ptr<DelayedFunctorInt> delegateDelayedFunctor(std::shared_ptr<DelayedFunctorInt> dfunctor) TP_OVERRIDE;
@@ -178,6 +619,105 @@ public:
 #ifndef NO_PRIORITY_TP_SUPPORT
 	///Implementations for PrioPoolInt
 	virtual FunctorInt *delegatePrioFunctor(FunctorInt *work) TP_OVERRIDE;
+
+	/**
+	 * Enable priority aging (time bucketed promotion)
+	 * - each functor gets the key priority - (enqueue time / step_ms) once at insertion
+	 * - higher key first -> a waiting functor passes newer ones with up to (waiting time / step_ms) higher priority
+	 * - no rescan of queued functors (only on change of step)
+	 * - only used by priority discipline (PrioScheduler)
+	 * @param step_ms	time per priority step (0: disable aging)
+	 */
+	virtual void setPrioAging(uint32_t step_ms) TP_OVERRIDE;
+
+	/**
+	 * Create reserved lane for high priority functors
+	 * - removes all previous reserved workers
+	 * - reserved workers only handle functors with priority >= prio_threshold
+	 * - normal workers still handle all functors
+	 * - reserved workers are not removed by dynamic worker handling
+	 * @param worker_count		count of reserved workers (0: remove lane)
+	 * @param prio_threshold	minimum functor priority handled by lane
+	 * @param lane_attr		creation attributes for lane workers, e.g. SCHED_FIFO (NULL: pool attributes)
+	 * @return true if all reserved workers could be created
+	 */
+	bool setReservedLane(uint8_t worker_count, uint8_t prio_threshold, const WorkerAttr *lane_attr = NULL);
+
+	/**
+	 * get count of reserved workers
+	 */
+	size_t getReservedWorkerCount(void){ return m_reserved_count; }
+
+	/**
+	 * get minimum functor priority handled by reserved workers
+	 */
+	uint8_t getReservedLaneThreshold(void){ return m_lane_threshold; }
+#endif
+#ifndef NO_DEADLINE_TP_SUPPORT
+	///Implementations for DeadlinePoolInt
+	/**
+	 * Add functor ordered by its deadline (earliest first)
+	 * - deadline queue is served before the normal functor queue
+	 * - reserved lane workers do not take deadline functors
+	 */
+	virtual FunctorInt *delegateDeadlineFunctor(FunctorInt *work) TP_OVERRIDE;
+	virtual void setDeadlinePolicy(uint8_t policy) TP_OVERRIDE;
+	virtual uint32_t getDeadlineMissCount(void) TP_OVERRIDE { return m_deadline_missed; }
+	virtual uint32_t getDeadlineDropCount(void) TP_OVERRIDE { return m_deadline_dropped; }
+
+	/**
+	 * get current count of functors within deadline queue
+	 */
+	size_t getDeadlineQueueCount(void);
+
+	/**
+	 * get current count of pending deadline stops (queued, running or not pruned yet)
+	 */
+	size_t getDeadlineStopCount(void);
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+	///Implementations for TenantPoolInt
+	virtual bool setTenant(uint16_t tenant_id, uint32_t weight, size_t queue_max = TENANT_FUNCTOR_MAX) TP_OVERRIDE;
+
+	/**
+	 * Add functor to sub queue of tenant (tenant is created with weight 1 on first use)
+	 * - tenant queues and normal functor queue (TP_TENANT_DEFAULT) are served by deficit round robin
+	 * - reserved lane workers do not take tenant functors
+	 */
+	virtual FunctorInt *delegateTenantFunctor(FunctorInt *work, uint16_t tenant_id) TP_OVERRIDE;
+
+	/**
+	 * get usage accounting of tenant
+	 * - TP_TENANT_DEFAULT: only weight, queue_max and queued
+	 */
+	virtual bool getTenantStats(uint16_t tenant_id, TenantStats &stats) TP_OVERRIDE;
+#endif
+#ifndef NO_RATE_TP_SUPPORT
+	///Implementations for RatePoolInt
+	virtual bool setRateLimit(uint16_t class_id, uint32_t rate, uint32_t burst = 1) TP_OVERRIDE;
+
+	/**
+	 * Add functor of rate class
+	 * - token taken lock-free, functor within budget is delegated directly (delegateFunctor)
+	 * - functor over budget is parked within delayed queue (DELAYED_FUNCTOR_MAX) until its token is available
+	 * - class without limit: same as delegateFunctor
+	 */
+	virtual FunctorInt *delegateRateFunctor(FunctorInt *work, uint16_t class_id) TP_OVERRIDE;
+	virtual bool getRateStats(uint16_t class_id, RateStats &stats) TP_OVERRIDE;
+#endif
+#ifndef NO_REACTOR_TP_SUPPORT
+	///Implementations for ReactorPoolInt
+	/**
+	 * - ready events are collected by the pool loop (epoll_wait, up to TP_REACTOR_EVENTS per call)
+	 *   and the handler is delegated directly (retried within next loop if queue is full)
+	 */
+	virtual bool registerFd(int fd, uint32_t events, FunctorInt *handler) TP_OVERRIDE;
+	virtual bool unregisterFd(int fd) TP_OVERRIDE;
+
+	/**
+	 * interrupt wait of pool loop (handle delayed functors, worker count, ... now)
+	 */
+	void wakeupReactor(void);
 #endif
 protected:
 
@@ -187,14 +727,414 @@ protected:
 	virtual void clearQueue(void) TP_OVERRIDE;
 	virtual void clearWorker(void) TP_OVERRIDE;
 
-	void wakeupWorker(void);
+	/**
+	 * take all queued functors (shared queue, mailboxes, deadline and tenant queues)
+	 * - m_functor_lock has to be locked by caller
+	 * - caller releases them by releaseFunctors after unlock (release may call pool functions)
+	 * @return count of taken functors
+	 */
+	size_t takeQueued(functor_queue_type &functors);
+
+	/**
+	 * release given unhandled functors (no pool lock held)
+	 */
+	void releaseFunctors(functor_queue_type &functors);
+
+	/**
+	 * get count of queued functors (shared queue, mailboxes, deadline and tenant queues)
+	 * - m_functor_lock has to be locked by caller
+	 */
+	size_t getQueuedCount(void);
+
+	/**
+	 * remove all workers: signal all of them, then join them
+	 * @param fast_shutdown	give up waiting for blocked functors (see WorkerThread)
+	 */
+	void joinWorker(bool fast_shutdown);
+
+	/**
+	 * create new WorkerThread and add it to internal worker list
+	 * @param worker_attr	creation attributes (NULL: pool attributes)
+	 * @param reserved	worker of reserved high priority lane
+	 * @return true on success , else false
+	 */
+	bool addWorkerThread(const WorkerAttr *worker_attr, bool reserved);
+
+	/**
+	 * wakeup one idle worker which is able to handle a functor with given priority
+	 * - normal workers are preferred, reserved workers only for priority >= lane threshold
+	 * @param priority	priority of new functor
+	 */
+	void wakeupWorker(uint8_t priority = 0);
+
+	/**
+	 * get next functor for given worker
+	 * - pool queues first if not empty (mailboxes, deadline and tenant queues), then
+	 *   concurrent scheduler (e.g. ShardedScheduler) without m_functor_lock
+	 * - set worker idle if nothing to do
+	 * @return functor object or NULL
+	 */
+	FunctorInt *fetchFunctor(WorkerThread *worker);
+
+	/**
+	 * check without m_functor_lock if mailboxes, deadline or tenant queues hold functors (hint only)
+	 */
+	bool hasPoolFunctors(void);
+
+	/**
+	 * get next functor for given worker from pool queues (locks m_functor_lock)
+	 * - set worker idle if nothing to do
+	 */
+	FunctorInt *fetchPoolFunctor(WorkerThread *worker);
+
+	/**
+	 * add functor to scheduler, count queue ticket
+	 * - locks m_functor_lock if scheduler is not concurrent
+	 * @param sched_mode	TP_SCHED_*
+	 */
+	void pushFunctor(FunctorInt *work, uint8_t sched_mode);
+
+	/**
+	 * take functor of concurrent scheduler without m_functor_lock (home shard of worker first)
+	 * @return NULL if scheduler is not concurrent or nothing to do
+	 */
+	FunctorInt *popConcurrentFunctor(WorkerThread *worker);
+
+	/**
+	 * remove next functor from queue
+	 * - m_functor_lock has to be locked by caller
+	 * @param reserved	only take functor for reserved lane
+	 * @param home		index of calling worker (preferred part of partitioned scheduler)
+	 * @param missed	set if caller has to call deadline_missed before handling (TP_DEADLINE_Report)
+	 * @return functor object or NULL
+	 */
+	FunctorInt *popFunctor(bool reserved, size_t home, bool &missed);
+
+	/**
+	 * remove next functor for given worker: own mailbox, shared queues, mailbox of other worker (stealing)
+	 * - m_functor_lock has to be locked by caller
+	 * @param worker	calling worker (NULL: no WorkerThread of this pool)
+	 * @param missed	see popFunctor
+	 */
+	FunctorInt *popWorkerFunctor(WorkerThread *worker, bool &missed);
+
+	/**
+	 * get normal (not reserved) worker by index
+	 * - m_worker_lock has to be locked by caller
+	 */
+	WorkerThread *findWorker(uint16_t worker_index);
+
+	/**
+	 * select normal worker by jump consistent hash of key (bucket = position in m_key_workers)
+	 * - m_worker_lock has to be locked by caller
+	 */
+	WorkerThread *findKeyWorker(uint64_t key);
+
+	/**
+	 * add/remove normal worker to/from m_key_workers (ordered by worker index)
+	 * - m_worker_lock has to be locked by caller
+	 */
+	void addKeyWorker(WorkerThread *worker);
+	void removeKeyWorker(WorkerThread *worker);
+
+	/**
+	 * add functor to mailbox of worker or return it if mailbox is full
+	 * - m_functor_lock has to be locked by caller
+	 */
+	FunctorInt *postMailbox(FunctorInt *work, WorkerThread *target);
+
+	///maximum count of functors within a mailbox
+	size_t		m_mailbox_limit;
+
+	///minimum mailbox size for stealing (0: no stealing)
+	size_t		m_mailbox_steal;
+
+	///normal workers ordered by worker index -> jump hash buckets (locked by m_worker_lock)
+	std::vector<WorkerThread*>	m_key_workers;
+
+	///key affinity in use -> delWorker retires highest bucket only (locked by m_worker_lock)
+	bool		m_key_affinity;
+
+	///count of functors within all mailboxes (changed with m_functor_lock, read without by fetchFunctor)
+	std::atomic<size_t>	m_mailbox_queued;
+
+	std::atomic<uint32_t>	m_mailbox_fallback;
+	std::atomic<uint32_t>	m_mailbox_stolen;
+
+	/**
+	 * add functor to queue without overload handling
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object
+	 */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *queueFunctor(FunctorInt *work, uint8_t add_mode);
+#else
+	FunctorInt *queueFunctor(FunctorInt *work);
+#endif
+
+	/**
+	 * handle functor refused by full queue according to overload policy
+	 * - called by delegating thread without m_functor_lock
+	 */
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *handleOverload(FunctorInt *work, uint8_t add_mode);
+#else
+	FunctorInt *handleOverload(FunctorInt *work);
+#endif
+
+	///current overload policy (TP_OVERLOAD_*)
+	uint8_t		m_overload_policy;
+
+	///user defined overload handler (TP_OVERLOAD_Custom)
+	OverloadHandlerInt	*p_overload_handler;
+
+	///count of overload events per policy
+	std::atomic<uint32_t>	m_overload_count[TP_OVERLOAD_COUNT];
+
+	///count of queued functors released by overload handling
+	std::atomic<uint32_t>	m_overload_dropped;
+
+	/**
+	 * count insertion into functor queue, create ticket for calling thread
+	 * - m_functor_lock has to be locked by caller
+	 */
+	void countEnqueue(FunctorInt *work, uint8_t level);
+
+	/**
+	 * count removal from functor queue
+	 * - m_functor_lock has to be locked by caller
+	 * - FIFO within level: cursor skips sequence numbers of evicted functors
+	 * @param evicted	removed from tail by overload (counted as gap, cursor unchanged)
+	 */
+	void countDequeue(FunctorInt *functor, bool evicted = false);
+
+	///functors inserted per priority level (written with m_functor_lock, read lock-free)
+	std::atomic<uint64_t>	m_level_enqueued[TP_QUEUE_LEVELS];
+
+	///functors removed per priority level (dequeue cursor: sequence number of next functor)
+	std::atomic<uint64_t>	m_level_dequeued[TP_QUEUE_LEVELS];
+
+	///functors evicted per priority level (gaps of sequence numbers)
+	std::atomic<uint64_t>	m_level_evicted[TP_QUEUE_LEVELS];
+
+	///evicted sequence numbers passed by dequeue cursor per priority level
+	std::atomic<uint64_t>	m_level_skipped[TP_QUEUE_LEVELS];
+
+	///highest priority level used so far (limits position calculation)
+	std::atomic<uint8_t>	m_max_level;
 
 	///lock functor queue
 	std::mutex	m_functor_lock;
 
+	///signaled when functor queue gets free space (used with m_functor_lock)
+	std::condition_variable	m_not_full;
+
+	///count of producers waiting for free queue space (changed with m_functor_lock, read without by concurrent pop)
+	std::atomic<uint32_t>	m_full_waiters;
+
+	///signaled when a WorkerThread finds no functor during shutdown (used with m_functor_lock)
+	std::condition_variable	m_drained;
+
+	///shutdown started
+	std::atomic<bool>	m_shutdown;
+
+	///stop source of running functors (requested by shutdown)
+	StopSource	m_stop_source;
+
 	///lock worker queue
 	std::mutex	m_worker_lock;
 
+	/**
+	 * delete compensating workers not needed anymore (idle ones only, without blocking lock)
+	 */
+	void retireCompensation(void);
+
+	///lock blocking accounting (locked before m_worker_lock)
+	std::mutex	m_blocking_lock;
+
+	///count of WorkerThreads within blocking section
+	std::atomic<uint32_t>	m_blocked_count;
+
+	///count of workers created for blocked ones (changed with m_blocking_lock, read without by main_loop)
+	std::atomic<uint32_t>	m_compensating;
+
+	/**
+	 * get lowest worker index which is not used by any worker
+	 * - m_worker_lock has to be locked by caller
+	 */
+	uint16_t getFreeWorkerIndex(void);
+
+	///creation attributes for new WorkerThreads (locked by m_worker_lock)
+	WorkerAttr	m_worker_attr;
+
+	///count of reserved high priority workers
+	size_t		m_reserved_count;
+
+	///minimum priority of functors handled by reserved workers
+	uint8_t		m_lane_threshold;
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+	///entry of deadline queue (binary min heap on deadline, FIFO on equal deadlines)
+	struct DeadlineEntry {
+		std::chrono::steady_clock::time_point deadline;
+		uint64_t seq;
+		FunctorInt *functor;
+
+		bool operator<(const DeadlineEntry &other) const {
+			// inverted -> std heap functions build a min heap
+			return (deadline != other.deadline) ? deadline > other.deadline : seq > other.seq;
+		}
+	};
+
+	/**
+	 * release functors dropped by popFunctor (deadline_missed, release)
+	 * - called without m_functor_lock
+	 */
+	void handleExpiredFunctors(void);
+
+	/**
+	 * call deadline_missed of expired functor (exceptions are ignored)
+	 * - called without m_functor_lock
+	 */
+	void reportMissed(FunctorInt *functor);
+
+	///deadline queue (locked by m_functor_lock)
+	std::vector<DeadlineEntry>	m_deadline_queue;
+
+	///insertion counter for deadline queue
+	uint64_t	m_deadline_seq;
+
+	///count of functors within deadline queue (changed with m_functor_lock, read without by fetchFunctor)
+	std::atomic<size_t>	m_deadline_queued;
+
+	///expired functors dropped by popFunctor (TP_DEADLINE_Drop, locked by m_functor_lock)
+	std::vector<FunctorInt*>	m_expired_functors;
+
+	///handling of expired functors (TP_DEADLINE_*, locked by m_functor_lock)
+	uint8_t		m_deadline_policy;
+
+	std::atomic<uint32_t>	m_deadline_missed;
+	std::atomic<uint32_t>	m_deadline_dropped;
+
+	///stop source of a functor which is stopped at its deadline
+	struct DeadlineStop {
+		std::chrono::steady_clock::time_point deadline;
+		StopSource source;
+
+		bool operator<(const DeadlineStop &other) const {
+			// inverted -> std heap functions build a min heap
+			return deadline > other.deadline;
+		}
+	};
+
+	/**
+	 * request stop of functors with passed deadline (pool loop)
+	 */
+	void checkDeadlineStops(void);
+
+	/**
+	 * remove deadline stops of finished functors (no token left) before the heap grows
+	 * - m_functor_lock has to be locked by caller
+	 */
+	void pruneDeadlineStops(void);
+
+	///deadline stops not reached yet (locked by m_functor_lock)
+	std::vector<DeadlineStop>	m_deadline_stops;
+
+	///size of m_deadline_stops for next pruning (amortized: twice the size left by last pruning)
+	size_t	m_deadline_stops_limit;
+#endif
+
+#ifndef NO_TENANT_TP_SUPPORT
+	///sub queue and accounting of one tenant (locked by m_functor_lock)
+	struct Tenant {
+		Tenant(): deficit(0), active(false) {
+			stats.weight = 1;
+			stats.queue_max = TENANT_FUNCTOR_MAX;
+			stats.queued = 0;
+			stats.submitted = 0;
+			stats.rejected = 0;
+			stats.dispatched = 0;
+		}
+
+		functor_queue_type queue;
+		int64_t deficit;
+		bool active;
+		TenantStats stats;
+	};
+
+	/**
+	 * get tenant object (create it on first use)
+	 * - m_functor_lock has to be locked by caller
+	 */
+	Tenant *getTenant(uint16_t tenant_id);
+
+	/**
+	 * add tenant to round robin list (and normal functor queue placeholder)
+	 * - m_functor_lock has to be locked by caller
+	 */
+	void activateTenant(Tenant *tenant);
+
+	/**
+	 * deficit round robin over active tenants
+	 * - m_functor_lock has to be locked by caller
+	 * @return functor of tenant or NULL (normal functor queue has to be served)
+	 */
+	FunctorInt *popTenantFunctor(void);
+
+	///tenant objects indexed by tenant id (locked by m_functor_lock)
+	std::vector<Tenant*>	m_tenants;
+
+	///round robin list of tenants with queued functors (locked by m_functor_lock)
+	std::deque<Tenant*>	m_active_tenants;
+
+	///placeholder of normal functor queue within round robin list
+	Tenant			m_default_tenant;
+
+	///count of functors within all tenant queues (changed with m_functor_lock, read without by fetchFunctor)
+	std::atomic<size_t>	m_tenant_queued;
+#endif
+
+#ifndef NO_RATE_TP_SUPPORT
+	///token bucket and accounting of one rate class
+	struct RateClass {
+		RateClass(): rate(0), burst(1), passed(0), parked(0), rejected(0) {}
+
+		TokenBucket bucket;
+		std::atomic<uint32_t> rate;
+		std::atomic<uint32_t> burst;
+		std::atomic<uint64_t> passed;
+		std::atomic<uint64_t> parked;
+		std::atomic<uint64_t> rejected;
+	};
+
+	///rate classes indexed by class id
+	RateClass	m_rate_classes[TP_RATE_CLASS_MAX];
+#endif
+
+#ifndef NO_REACTOR_TP_SUPPORT
+	/**
+	 * wait for ready file descriptors and delegate their handlers (pool loop)
+	 * @param timeout_us	maximum wait time (rounded up to ms)
+	 */
+	void waitReactor(uint32_t timeout_us);
+
+	///epoll instance (-1: not usable -> pool loop sleeps)
+	int		m_epoll_fd;
+
+	///eventfd to interrupt epoll_wait
+	int		m_wakeup_fd;
+
+	///lock registered handlers
+	std::mutex	m_reactor_lock;
+
+	///registered handlers by file descriptor (locked by m_reactor_lock)
+	std::map<int, IoFunctorInt*>	m_io_handlers;
+
+	///ready handlers not accepted by full functor queue (locked by m_reactor_lock)
+	std::vector<IoFunctorInt*>	m_io_retry;
+#endif
+
 #ifndef NO_DELAYED_TP_SUPPORT
 
 	///Implementations for DelayedPoolInt
@@ -202,8 +1142,14 @@ protected:
 
 	/**
 	 *	clear delayed list
+	 *	- stored functors are released unhandled (functor_release)
 	 */
 	virtual void clearDelayedList( void ) TP_OVERRIDE;
+
+	/**
+	 * release stored functors of dropped delayed entries (no pool lock held)
+	 */
+	void releaseDelayedFunctors(delayed_list_type &dfunctors);
 #endif
 #ifndef NO_DYNAMIC_TP_SUPPORT
 	///Implementations for DynamicPoolInt
@@ -272,6 +1218,30 @@ protected:
 
 };
 
+///Blocking section of a functor (scope guard for beginBlocking/endBlocking)
+/**
+ * {
+ *     BlockingScope blocking(pool);
+ *     read(fd, ...);		// pool keeps its throughput meanwhile
+ * }
+ */
+class BlockingScope {
+public:
+	BlockingScope(ThreadPool *pool): p_pool(pool), m_counted(pool && pool->beginBlocking()) {}
+	~BlockingScope(){ if (m_counted) p_pool->endBlocking(); }
+
+private:
+	BlockingScope(const BlockingScope&);
+	BlockingScope &operator=(const BlockingScope&);
+
+	ThreadPool *p_pool;
+	bool m_counted;
+};
+
 } /* namespace threadpool */
 } /* namespace icke2063 */
+
+#ifdef TP_COROUTINE_SUPPORT
+	#include "ThreadPoolCoro.h"
+#endif
 #endif /* THREADPOOL_H_ */
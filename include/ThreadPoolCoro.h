@@ -0,0 +1,323 @@
+/**
+ * @file   ThreadPoolCoro.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  C++20 coroutine integration: co_await pool.schedule(), Task<T>
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef THREADPOOLCORO_H_
+#define THREADPOOLCORO_H_
+
+#include <ThreadPool.h>
+
+#ifdef TP_COROUTINE_SUPPORT
+
+//C++20
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <atomic>
+#include <utility>
+
+#include "Futex.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+///Awaitable to continue a coroutine within a WorkerThread
+/**
+ * The awaiter object lives within the coroutine frame while the coroutine is suspended
+ * and is delegated itself as functor -> no allocation per resume.
+ * functor_execute only resumes the coroutine (the frame and this object may be gone afterwards).
+ * If the pool releases it unhandled (overload, clearQueue, shutdown) the coroutine is resumed within
+ * the releasing thread and co_await throws std::runtime_error.
+ */
+class ScheduleAwaiter: public Functor {
+public:
+	ScheduleAwaiter(BasePoolInt *pool): p_pool(pool), m_cancelled(false) {}
+	virtual ~ScheduleAwaiter() {}
+
+	bool await_ready(void) const noexcept { return false; }
+
+	/**
+	 * delegate this object to pool
+	 * @return false if pool did not take it -> continue within calling thread
+	 */
+	bool await_suspend(std::coroutine_handle<> handle) noexcept {
+		m_handle = handle;
+		return p_pool->delegateFunctor(this) == NULL;	// no access to this object after success
+	}
+
+	void await_resume(void) const {
+		if (m_cancelled)
+		{
+			throw std::runtime_error("icke2063::ScheduleAwaiter: released by pool");
+		}
+	}
+
+	virtual void functor_function(void) TP_OVERRIDE { m_handle.resume(); }
+
+	/**
+	 * released unhandled by pool -> resume coroutine as cancelled (frame is owned by coroutine)
+	 */
+	virtual void functor_release(void) TP_OVERRIDE {
+		m_cancelled = true;
+		m_handle.resume();
+	}
+
+	/**
+	 * only resume coroutine (frame including this object may be destroyed by it)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE { m_handle.resume(); }
+
+private:
+	BasePoolInt *p_pool;
+	std::coroutine_handle<> m_handle;
+	bool m_cancelled;
+};
+
+inline ScheduleAwaiter ThreadPool::schedule(void)
+{
+	return ScheduleAwaiter(this);
+}
+
+#ifndef NO_DELAYED_TP_SUPPORT
+///Functor to resume coroutine after delay (owned by DelayedFunctor until due)
+/**
+ * If the pool drops it unhandled (clearDelayedList, shutdown, overload) the coroutine is resumed
+ * within the releasing thread and co_await throws std::runtime_error.
+ */
+class ResumeFunctor: public Functor {
+public:
+	ResumeFunctor(std::coroutine_handle<> handle, bool *cancelled): m_handle(handle), p_cancelled(cancelled) {}
+	virtual ~ResumeFunctor() {}
+
+	virtual void functor_function(void) TP_OVERRIDE { m_handle.resume(); }
+
+	/**
+	 * released unhandled by pool -> resume coroutine as cancelled
+	 */
+	virtual void functor_release(void) TP_OVERRIDE {
+		std::coroutine_handle<> handle = m_handle;
+
+		*p_cancelled = true;	// flag lives within awaiter of suspended frame
+		delete this;
+		handle.resume();
+	}
+
+	/**
+	 * delete before resume (coroutine may destroy pool or wait for it)
+	 */
+	virtual void functor_execute(void) TP_OVERRIDE {
+		std::coroutine_handle<> handle = m_handle;
+
+		delete this;
+		handle.resume();
+	}
+
+private:
+	std::coroutine_handle<> m_handle;
+	bool *p_cancelled;
+};
+
+///Awaitable to continue a coroutine within a WorkerThread after given delay
+class DelayAwaiter {
+public:
+	DelayAwaiter(DelayedPoolInt *pool, std::chrono::steady_clock::duration delay):
+		p_pool(pool), m_delay(delay), m_cancelled(false) {}
+
+	bool await_ready(void) const noexcept { return false; }
+
+	/**
+	 * add resume functor to delayed queue of pool
+	 * @return false if pool did not take it -> continue within calling thread
+	 */
+	bool await_suspend(std::coroutine_handle<> handle) {
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + m_delay;
+		std::shared_ptr<DelayedFunctorInt> dfunctor(new DelayedFunctor(new ResumeFunctor(handle, &m_cancelled), deadline));
+
+		if (p_pool->delegateDelayedFunctor(dfunctor).get() == NULL)
+		{
+			return true;
+		}
+
+		// not added -> continue within calling thread (delete only, no resume)
+		delete dfunctor->releaseFunctor();
+		return false;
+	}
+
+	void await_resume(void) const {
+		if (m_cancelled)
+		{
+			throw std::runtime_error("icke2063::DelayAwaiter: released by pool");
+		}
+	}
+
+private:
+	DelayedPoolInt *p_pool;
+	std::chrono::steady_clock::duration m_delay;
+	bool m_cancelled;
+};
+
+inline DelayAwaiter DelayedPoolInt::scheduleAfter(std::chrono::steady_clock::duration delay)
+{
+	return DelayAwaiter(this, delay);
+}
+#endif
+
+template <typename T> class Task;
+
+///Base of Task promise: continuation and completion flag
+class TaskPromiseBase {
+public:
+	TaskPromiseBase(): m_done(0) {}
+
+	///resume awaiting coroutine (symmetric transfer -> same WorkerThread) or wake blocking get()
+	struct FinalAwaiter {
+		bool await_ready(void) const noexcept { return false; }
+
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+			TaskPromiseBase &promise = handle.promise();
+			std::coroutine_handle<> continuation = promise.m_continuation;
+			std::atomic<int32_t> *done = &promise.m_done;
+
+			if (continuation)
+			{
+				return continuation;
+			}
+			// get() may return and destroy frame after store -> only use address as futex key
+			done->store(1, std::memory_order_release);
+			futex_wake(done);
+			return std::noop_coroutine();
+		}
+
+		void await_resume(void) const noexcept {}
+	};
+
+	std::suspend_always initial_suspend(void) noexcept { return std::suspend_always(); }
+	FinalAwaiter final_suspend(void) noexcept { return FinalAwaiter(); }
+	void unhandled_exception(void) { m_exception = std::current_exception(); }
+
+	void setContinuation(std::coroutine_handle<> continuation) { m_continuation = continuation; }
+
+	/**
+	 * block calling thread until coroutine is completed (without continuation)
+	 */
+	void waitDone(void) {
+		while (m_done.load(std::memory_order_acquire) == 0)
+		{
+			futex_wait(&m_done, 0);
+		}
+	}
+
+	void rethrow(void) {
+		if (m_exception)
+		{
+			std::rethrow_exception(m_exception);
+		}
+	}
+
+protected:
+	std::coroutine_handle<> m_continuation;
+	std::exception_ptr m_exception;
+	std::atomic<int32_t> m_done;
+};
+
+template <typename T>
+class TaskPromise: public TaskPromiseBase {
+public:
+	Task<T> get_return_object(void);
+	void return_value(T value) { m_value = std::move(value); }
+	T &result(void) { rethrow(); return m_value; }
+
+private:
+	T m_value;
+};
+
+template <>
+class TaskPromise<void>: public TaskPromiseBase {
+public:
+	Task<void> get_return_object(void);
+	void return_void(void) {}
+	void result(void) { rethrow(); }
+};
+
+///Lazy coroutine task
+/**
+ * The coroutine starts when it is awaited (or by get()). If it moves itself to the pool
+ * (co_await pool.schedule()) the awaiting coroutine is resumed on the same WorkerThread
+ * after completion (symmetric transfer, no extra queue round trip).
+ */
+template <typename T = void>
+class Task {
+public:
+	typedef TaskPromise<T> promise_type;
+
+	explicit Task(std::coroutine_handle<promise_type> handle): m_handle(handle) {}
+	Task(Task &&other) noexcept: m_handle(other.m_handle) { other.m_handle = nullptr; }
+	Task(const Task &) = delete;
+	Task &operator=(const Task &) = delete;
+
+	~Task() {
+		if (m_handle)
+		{
+			m_handle.destroy();
+		}
+	}
+
+	bool await_ready(void) const noexcept { return false; }
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+		m_handle.promise().setContinuation(continuation);
+		return m_handle;
+	}
+
+	decltype(auto) await_resume(void) { return m_handle.promise().result(); }
+
+	/**
+	 * start task and block calling thread until it is completed
+	 * - do not call it from a WorkerThread of the used pool
+	 */
+	decltype(auto) get(void) {
+		m_handle.resume();
+		m_handle.promise().waitDone();
+		return m_handle.promise().result();
+	}
+
+private:
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object(void)
+{
+	return Task<T>(std::coroutine_handle<TaskPromise<T> >::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object(void)
+{
+	return Task<void>(std::coroutine_handle<TaskPromise<void> >::from_promise(*this));
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif /* TP_COROUTINE_SUPPORT */
+#endif /* THREADPOOLCORO_H_ */
@@ -37,6 +37,8 @@
 
 #include <icke2063_TP_config.h>
 
+#include "SchedulerPoolInt.h"
+
 #ifndef WORKERTHREAD_MAX
 	#define WORKERTHREAD_MAX	60
 #endif
@@ -45,6 +47,13 @@
 	#define FUNCTOR_MAX	1024
 #endif
 
+/**
+ * C++20 coroutine support (co_await pool.schedule())
+ */
+#if !defined(NO_COROUTINE_TP_SUPPORT) && defined(__cpp_impl_coroutine)
+	#define TP_COROUTINE_SUPPORT	1
+#endif
+
 namespace icke2063 {
 namespace threadpool {
 
@@ -65,6 +74,31 @@ public:
 	 * @brief This function will be called by WorkerThreadInt of ThreadPool
 	 */
 	virtual void functor_function(void) = 0;
+
+	/**
+	 * Function called by ThreadPool when the functor is not needed anymore
+	 * (after functor_function or on removal of queued functor)
+	 * @brief default: delete object, overwrite it to keep reusable functor objects
+	 */
+	virtual void functor_release(void){ delete this; }
+
+	/**
+	 * Function called by WorkerThread to handle the functor
+	 * @brief default: functor_function followed by functor_release (also on exception)
+	 * 		Overwrite it if the object may be gone after functor_function (e.g. coroutine frame).
+	 */
+	virtual void functor_execute(void){
+		try
+		{
+			functor_function();
+		}
+		catch (...)
+		{
+			functor_release();
+			throw;
+		}
+		functor_release();
+	}
 };
 
 ///WorkerThread of ThreadPool
@@ -110,13 +144,14 @@ public:
 	 * Base constructor for threadpool interface
 	 * - depending classes should initiate worker threads
 	 */
-	BasePoolInt(){}
+	BasePoolInt():p_scheduler(NULL){}
 
 	/**
 	 * Base destructor for threadpool interface
 	 * - depending classes shall
 	 * 		* reset worker threads
 	 * 		* clear functor list
+	 * 		* delete scheduler
 	 */
 	virtual ~BasePoolInt(){}
 
@@ -134,12 +169,12 @@ public:
 	/**
 	 * get current worker count within worker list
 	 */
-	size_t getWorkerCount(void){ return m_workerThreads.size(); }
+	virtual size_t getWorkerCount(void){ return m_workerThreads.size(); }
 
 	/**
 	 * get current functor size of functor queue
 	 */
-	uint16_t getQueueCount(){ return m_functor_queue.size(); }
+	uint16_t getQueueCount(){ return p_scheduler ? p_scheduler->size() : 0; }
 
 protected:
 
@@ -172,7 +207,9 @@ protected:
 protected:
 	///list of waiting functors
 	typedef std::deque<FunctorInt *> functor_queue_type;
-	functor_queue_type  	m_functor_queue;
+
+	///queue discipline of waiting functors (created by inherit class)
+	SchedulerInt		*p_scheduler;
 
 	///list of used WorkerThreadInts
 	typedef std::list<WorkerThreadInt*> worker_list_type;
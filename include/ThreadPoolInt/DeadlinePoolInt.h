@@ -0,0 +1,117 @@
+/**
+ * @file   DeadlinePoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for the earliest-deadline-first (EDF) Threadpool extension
+ * 		Functors carry an absolute completion deadline. They are stored within an extra queue
+ * 		ordered by deadline (earliest first) which is served before the normal functor queue.
+ * 		Functors found expired at dequeue can be handled anyway, reported or dropped.
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _DEADLINE_THREADPOOL_H_
+#define _DEADLINE_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+
+#include <stdint.h>
+
+//C++11
+#include <chrono>
+
+#include "BasePoolInt.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+/**
+ * handling of functors found expired at dequeue
+ */
+#define TP_DEADLINE_Run		0	///< handle functor anyway (only counted)
+#define TP_DEADLINE_Report	1	///< call deadline_missed, then handle functor
+#define TP_DEADLINE_Drop	2	///< call deadline_missed, release functor without handling
+
+///Functor extension with completion deadline
+class DeadlineFunctorInt {
+public:
+	DeadlineFunctorInt():m_deadline(std::chrono::steady_clock::time_point::max()){};
+	virtual ~DeadlineFunctorInt(){};
+
+	/**
+	 * set absolute completion deadline
+	 */
+	void setDeadline(std::chrono::steady_clock::time_point deadline){m_deadline = deadline;}
+
+	/**
+	 * set completion deadline relative to now
+	 */
+	void setDeadlineIn(std::chrono::steady_clock::duration timeout){
+		m_deadline = std::chrono::steady_clock::now() + timeout;
+	}
+
+	std::chrono::steady_clock::time_point getDeadline(){return m_deadline;}
+
+	/**
+	 * called by WorkerThread if functor was found expired at dequeue (TP_DEADLINE_Report/Drop)
+	 * - called outside of pool locks
+	 */
+	virtual void deadline_missed(void){}
+
+private:
+	/**
+	 * absolute timestamp until the functor should be completed
+	 */
+	std::chrono::steady_clock::time_point m_deadline;
+};
+
+class DeadlinePoolInt {
+public:
+	DeadlinePoolInt(){};
+	virtual ~DeadlinePoolInt(){}
+
+	/**
+	 * Add functor object (has to implement DeadlineFunctorInt) ordered by its deadline
+	 * MUST be implemented in inherit class (correct usage of locks, threads, ...)
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+	virtual FunctorInt *delegateDeadlineFunctor(FunctorInt *work) = 0;
+
+	/**
+	 * set handling of functors found expired at dequeue (TP_DEADLINE_*)
+	 */
+	virtual void setDeadlinePolicy(uint8_t policy) = 0;
+
+	/**
+	 * get count of functors found expired at dequeue
+	 */
+	virtual uint32_t getDeadlineMissCount(void) = 0;
+
+	/**
+	 * get count of dropped expired functors
+	 */
+	virtual uint32_t getDeadlineDropCount(void) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif
+#endif /* _DEADLINE_THREADPOOL_H_ */
@@ -47,6 +47,9 @@
 namespace icke2063 {
 namespace threadpool {
 
+#ifdef TP_COROUTINE_SUPPORT
+class DelayAwaiter;
+#endif
   
 class DelayedFunctorInt{
  public:
@@ -142,6 +145,14 @@ public:
 	virtual std::shared_ptr<DelayedFunctorInt>
 	delegateDelayedFunctor(std::shared_ptr<DelayedFunctorInt> dfunctor) = 0;
 
+#ifdef TP_COROUTINE_SUPPORT
+	/**
+	 * awaitable to continue calling coroutine after given delay within a WorkerThread
+	 * - co_await pool.scheduleAfter(std::chrono::milliseconds(10));
+	 */
+	DelayAwaiter scheduleAfter(std::chrono::steady_clock::duration delay);
+#endif
+
 protected:
 
 	/**
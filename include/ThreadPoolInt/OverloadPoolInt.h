@@ -0,0 +1,89 @@
+/**
+ * @file   OverloadPoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for configurable handling of functors delegated to a full functor queue
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _OVERLOAD_THREADPOOL_H_
+#define _OVERLOAD_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+
+#include "BasePoolInt.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+/**
+ * overload policies (functor queue full)
+ */
+#define TP_OVERLOAD_Reject	0	///< return functor to caller (default)
+#define TP_OVERLOAD_CallerRuns	1	///< handle functor within delegating thread
+#define TP_OVERLOAD_DropOldest	2	///< release functor queued first, add new functor
+#define TP_OVERLOAD_EvictLowest	3	///< release lowest priority functor if new one has higher priority
+#define TP_OVERLOAD_Custom	4	///< call OverloadHandlerInt
+#define TP_OVERLOAD_COUNT	5
+
+///User defined overload handling
+class OverloadHandlerInt {
+public:
+	OverloadHandlerInt(){};
+	virtual ~OverloadHandlerInt(){};
+
+	/**
+	 * called by delegating thread if functor queue is full
+	 * @param work	refused functor
+	 * @return		NULL: functor taken by handler
+	 * 			else: functor returned to caller of delegateFunctor
+	 */
+	virtual FunctorInt *handleOverload(FunctorInt *work) = 0;
+};
+
+class OverloadPoolInt {
+public:
+	OverloadPoolInt(){};
+	virtual ~OverloadPoolInt(){}
+
+	/**
+	 * set handling of functors delegated to full functor queue (TP_OVERLOAD_*)
+	 * - not used for delegations by the pool thread (due delayed functors, ready I/O handlers):
+	 *   they are retried by the pool loop (policies may run or release functors with pool locks held)
+	 * @param handler	user defined handler for TP_OVERLOAD_Custom (not deleted by pool)
+	 * @return false on invalid policy
+	 */
+	virtual bool setOverloadPolicy(uint8_t policy, OverloadHandlerInt *handler = NULL) = 0;
+
+	/**
+	 * get count of overload events handled by given policy
+	 */
+	virtual uint32_t getOverloadCount(uint8_t policy) = 0;
+
+	/**
+	 * get count of queued functors released by overload handling (dropped or evicted)
+	 */
+	virtual uint32_t getOverloadDropCount(void) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif /* _OVERLOAD_THREADPOOL_H_ */
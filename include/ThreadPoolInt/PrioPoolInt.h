@@ -48,7 +48,7 @@ namespace threadpool {
 class PrioFunctorInt {
     #define TPI_ADD_Prio	10 
 public:
-	PrioFunctorInt():m_priority(0){};
+	PrioFunctorInt():m_priority(0),m_queue_level(0),m_queue_seq(0),m_prio_key(0){};
 	virtual ~PrioFunctorInt(){};
 	
 	/**
@@ -58,6 +58,25 @@ public:
 	 */
 	void setPriority(uint8_t prio){m_priority = (prio<=100)?prio:100;}
 	uint8_t getPriority(){return m_priority;}
+
+	/**
+	 * set/get queue order key (used by pool with priority aging)
+	 * - priority minus enqueue time bucket -> does not change while queued
+	 */
+	void setPrioKey(int64_t key){m_prio_key = key;}
+	int64_t getPrioKey(){return m_prio_key;}
+
+	/**
+	 * set/get priority level used for queue position counters (priority at insertion)
+	 */
+	void setQueueLevel(uint8_t level){m_queue_level = level;}
+	uint8_t getQueueLevel(){return m_queue_level;}
+
+	/**
+	 * set/get sequence number within queue level (position ticket)
+	 */
+	void setQueueSeq(uint64_t seq){m_queue_seq = seq;}
+	uint64_t getQueueSeq(){return m_queue_seq;}
 	
 private:
   
@@ -68,6 +87,21 @@ private:
    * 
    */
   uint8_t m_priority;
+
+  /**
+   * priority level at insertion into queue
+   */
+  uint8_t m_queue_level;
+
+  /**
+   * sequence number within queue level
+   */
+  uint64_t m_queue_seq;
+
+  /**
+   * queue order key (higher key first)
+   */
+  int64_t m_prio_key;
 };
 
 ///Abstract ThreadPool interface
@@ -82,6 +116,13 @@ public:
 	 * MUST be implemented in inherit class (correct usage of locks, threads, ...)
 	 */
 	virtual FunctorInt *delegatePrioFunctor(FunctorInt *work) = 0;
+
+	/**
+	 * Enable priority aging: effective priority rises by one each step_ms while queued
+	 * - prevents starvation of low priority functors
+	 * @param step_ms	time per priority step (0: disable aging)
+	 */
+	virtual void setPrioAging(uint32_t step_ms) = 0;
 	
 };
 
@@ -0,0 +1,161 @@
+/**
+ * @file   RatePoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for rate limited functor classes
+ * 		Each class has a token bucket (rate per second, burst). Functors over budget are
+ * 		parked within the delayed queue until their token is available, so no WorkerThread
+ * 		waits for the budget. Needs delayed function support.
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _RATE_THREADPOOL_H_
+#define _RATE_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+// functors over budget are parked within the delayed queue
+#if defined(NO_DELAYED_TP_SUPPORT) && !defined(NO_RATE_TP_SUPPORT)
+	#define NO_RATE_TP_SUPPORT	1
+#endif
+
+#ifndef NO_RATE_TP_SUPPORT
+
+#include <stdint.h>
+
+//C++11
+#include <atomic>
+#include <chrono>
+
+#include "BasePoolInt.h"
+
+/**
+ * count of rate limited functor classes (class id 0 .. TP_RATE_CLASS_MAX-1)
+ */
+#ifndef TP_RATE_CLASS_MAX
+	#define TP_RATE_CLASS_MAX	16
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///usage accounting of one rate class
+struct RateStats {
+	uint32_t rate;			///< functors per second (0: unlimited)
+	uint32_t burst;			///< functors passed without delay after idle time
+	uint64_t passed;		///< functors delegated immediately
+	uint64_t parked;		///< functors parked within delayed queue
+	uint64_t rejected;		///< functors not accepted (pool or delayed queue full)
+};
+
+///Lock-free token bucket
+/**
+ * Stored as theoretical arrival time of the next token (GCRA): one atomic value, one CAS per functor.
+ * A functor always reserves the next token, the returned delay tells when this token is available
+ * -> parked functors keep their order and need no retry.
+ */
+class TokenBucket {
+public:
+	TokenBucket(): m_tat(0), m_interval_ns(0), m_burst_ns(0) {}
+
+	/**
+	 * configure bucket
+	 * @param rate	tokens per second (0: unlimited)
+	 * @param burst	bucket size (>= 1)
+	 */
+	void setRate(uint32_t rate, uint32_t burst){
+		int64_t interval = (rate > 0) ? 1000000000LL / rate : 0;
+		m_interval_ns.store(interval, std::memory_order_relaxed);
+		m_burst_ns.store(interval * ((burst > 0) ? burst : 1), std::memory_order_relaxed);
+		m_tat.store(0, std::memory_order_release);	// start with full bucket
+	}
+
+	bool isLimited(void){ return m_interval_ns.load(std::memory_order_relaxed) > 0; }
+
+	/**
+	 * reserve next token
+	 * @param now_ns	current time
+	 * @return time until token is available (0: immediately)
+	 */
+	int64_t reserve(int64_t now_ns){
+		int64_t interval = m_interval_ns.load(std::memory_order_relaxed);
+		int64_t burst = m_burst_ns.load(std::memory_order_relaxed);
+		int64_t tat = m_tat.load(std::memory_order_relaxed);
+		int64_t new_tat;
+
+		do {
+			new_tat = ((tat > now_ns) ? tat : now_ns) + interval;
+		} while (!m_tat.compare_exchange_weak(tat, new_tat, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+		int64_t delay = new_tat - burst - now_ns;
+		return (delay > 0) ? delay : 0;
+	}
+
+	/**
+	 * give back last reserved token (functor not accepted)
+	 */
+	void cancel(void){
+		m_tat.fetch_sub(m_interval_ns.load(std::memory_order_relaxed), std::memory_order_acq_rel);
+	}
+
+private:
+	///theoretical arrival time of next token (steady clock ns)
+	std::atomic<int64_t> m_tat;
+
+	///time per token
+	std::atomic<int64_t> m_interval_ns;
+
+	///bucket size as time
+	std::atomic<int64_t> m_burst_ns;
+};
+
+class RatePoolInt {
+public:
+	RatePoolInt(){};
+	virtual ~RatePoolInt(){}
+
+	/**
+	 * configure rate class
+	 * @param class_id	rate class (< TP_RATE_CLASS_MAX)
+	 * @param rate		functors per second (0: remove limit)
+	 * @param burst		functors passed without delay after idle time
+	 * @return false on invalid class
+	 */
+	virtual bool setRateLimit(uint16_t class_id, uint32_t rate, uint32_t burst = 1) = 0;
+
+	/**
+	 * Add functor object of rate class
+	 * - functor over budget is parked within delayed queue until its token is available
+	 * MUST be implemented in inherit class (correct usage of locks, threads, ...)
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+	virtual FunctorInt *delegateRateFunctor(FunctorInt *work, uint16_t class_id) = 0;
+
+	/**
+	 * get usage accounting of rate class
+	 * @return false on invalid class
+	 */
+	virtual bool getRateStats(uint16_t class_id, RateStats &stats) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif
+#endif /* _RATE_THREADPOOL_H_ */
@@ -0,0 +1,162 @@
+/**
+ * @file   ReactorPoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for the I/O reactor of the Threadpool (linux epoll)
+ * 		File descriptors are registered with a handler functor. The pool loop waits on epoll
+ * 		(edge triggered, batched) and delegates the handler of each ready descriptor directly.
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _REACTOR_THREADPOOL_H_
+#define _REACTOR_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#ifndef NO_REACTOR_TP_SUPPORT
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+//C++11
+#include <atomic>
+
+#include "BasePoolInt.h"
+
+/**
+ * maximum count of events taken by one epoll_wait call
+ */
+#ifndef TP_REACTOR_EVENTS
+	#define TP_REACTOR_EVENTS	64
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+///Handler extension for ready file descriptors
+/**
+ * Events arriving while the handler is queued or running are collected and handled by the same
+ * run -> one handler is never handled by two WorkerThreads at the same time.
+ * Descriptors are edge triggered: io_ready has to read/write until EAGAIN.
+ */
+class IoFunctorInt {
+public:
+	IoFunctorInt():p_functor(NULL),m_fd(-1),m_ready(0),m_pending(0){};
+	virtual ~IoFunctorInt(){};
+
+	/**
+	 * called by WorkerThread with collected epoll events (EPOLLIN, EPOLLOUT, EPOLLHUP, ...)
+	 */
+	virtual void io_ready(uint32_t events) = 0;
+
+	/**
+	 * get registered file descriptor (-1: not registered)
+	 */
+	int getFd(void){return m_fd;}
+
+	/**
+	 * set registration (reactor)
+	 */
+	void setRegistration(int fd, FunctorInt *functor){m_fd = fd; p_functor = functor;}
+
+	/**
+	 * get functor object delegated on ready events
+	 */
+	FunctorInt *getFunctor(void){return p_functor;}
+
+	/**
+	 * check if handler is queued or running
+	 * - wait for false after unregisterFd before deleting the handler
+	 */
+	bool isPending(void){return m_pending.load(std::memory_order_acquire) > 0;}
+
+	/**
+	 * add ready events (reactor)
+	 * @return true if handler has to be delegated
+	 */
+	bool addReadyEvents(uint32_t events){
+		m_ready.fetch_or(events, std::memory_order_acq_rel);
+		return m_pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+	}
+
+	/**
+	 * drop collected events of handler which is not queued (reactor)
+	 */
+	void cancelReady(void){
+		m_ready.store(0, std::memory_order_relaxed);
+		m_pending.store(0, std::memory_order_release);
+	}
+
+	/**
+	 * handle collected events until no new ones arrived (WorkerThread)
+	 */
+	void dispatchReady(void){
+		int32_t pending = m_pending.load(std::memory_order_acquire);
+		while (pending > 0)
+		{
+			uint32_t events = m_ready.exchange(0, std::memory_order_acq_rel);
+			if (events)
+			{
+				io_ready(events);
+			}
+			// no access to handler after last decrement
+			pending = m_pending.fetch_sub(pending, std::memory_order_acq_rel) - pending;
+		}
+	}
+
+private:
+	///functor object delegated on ready events (set by registerFd)
+	FunctorInt *p_functor;
+
+	///registered file descriptor
+	int m_fd;
+
+	///collected events
+	std::atomic<uint32_t> m_ready;
+
+	///count of ready notifications not handled yet (0: not queued)
+	std::atomic<int32_t> m_pending;
+};
+
+class ReactorPoolInt {
+public:
+	ReactorPoolInt(){};
+	virtual ~ReactorPoolInt(){}
+
+	/**
+	 * register file descriptor with handler functor
+	 * @param fd		file descriptor (should be non blocking)
+	 * @param events	epoll events (EPOLLIN, EPOLLOUT, ...), always edge triggered
+	 * @param handler	functor implementing IoFunctorInt (owned by caller, not released by pool)
+	 * @return false on failure
+	 */
+	virtual bool registerFd(int fd, uint32_t events, FunctorInt *handler) = 0;
+
+	/**
+	 * remove file descriptor from reactor
+	 * - no new delegation of its handler after return
+	 * @return false if descriptor is unknown
+	 */
+	virtual bool unregisterFd(int fd) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif
+#endif /* _REACTOR_THREADPOOL_H_ */
@@ -0,0 +1,120 @@
+/**
+ * @file   SchedulerPoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for the queue discipline of the shared functor queue (exchangeable at pool construction)
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _SCHEDULER_THREADPOOL_H_
+#define _SCHEDULER_THREADPOOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace icke2063 {
+namespace threadpool {
+
+class FunctorInt;
+
+/**
+ * position requested by delegating function (disciplines may ignore it)
+ */
+#define TP_SCHED_Back	0	///< behind queued functors (TPI_ADD_FiFo)
+#define TP_SCHED_Front	1	///< before queued functors (TPI_ADD_LiFo)
+#define TP_SCHED_Prio	2	///< ordered by functor priority (TPI_ADD_Default/TPI_ADD_Prio)
+
+///Queue discipline of the shared functor queue
+/**
+ * The pool owns the scheduler and calls all functions with locked functor queue
+ * -> implementations need no own locking. Functors are only stored, never handled or released.
+ * Concurrent implementations (isConcurrent) lock themselves and are also called without pool lock.
+ */
+class SchedulerInt {
+public:
+	SchedulerInt(){};
+	virtual ~SchedulerInt(){};
+
+	/**
+	 * get name of discipline (createScheduler, benchmark output)
+	 */
+	virtual const char *getName(void) = 0;
+
+	/**
+	 * add functor (always succeeds, queue limit is checked by pool)
+	 * @param add_mode	TP_SCHED_*
+	 * @return queue level for position tickets (functors of higher levels are handled first)
+	 */
+	virtual uint8_t push(FunctorInt *work, uint8_t add_mode) = 0;
+
+	/**
+	 * remove next functor to handle
+	 * @param min_priority	>0: take first functor with at least this priority within the next
+	 * 						TP_RESERVED_SCAN ones (reserved lane)
+	 * @return NULL if empty or no scanned functor reaches min_priority
+	 */
+	virtual FunctorInt *pop(uint8_t min_priority) = 0;
+
+	/**
+	 * remove next functor to handle for given WorkerThread
+	 * @param home	index of calling WorkerThread (preferred part of a partitioned queue)
+	 */
+	virtual FunctorInt *popHome(uint8_t min_priority, size_t home){ (void)home; return pop(min_priority); }
+
+	/**
+	 * remove functor handled last if its priority is lower than given one (TP_OVERLOAD_EvictLowest)
+	 * @return NULL if no functor can be evicted
+	 */
+	virtual FunctorInt *evict(uint8_t priority) = 0;
+
+	/**
+	 * remove functor queued first (TP_OVERLOAD_DropOldest)
+	 * - default: next functor to handle (FIFO order)
+	 * @return NULL if empty
+	 */
+	virtual FunctorInt *popOldest(void){ return pop(0); }
+
+	/**
+	 * get count of queued functors
+	 */
+	virtual size_t size(void) = 0;
+
+	/**
+	 * get position of functor in handling order (-1: not queued)
+	 */
+	virtual int getPos(FunctorInt *work) = 0;
+
+	/**
+	 * change priority aging (ignored by disciplines without priority order)
+	 * @param step_ms	time per priority step (0: disable aging)
+	 */
+	virtual void setAging(uint32_t step_ms){ (void)step_ms; }
+
+	/**
+	 * check if push, pop/popHome and size are thread-safe without pool lock
+	 * - pool then adds and takes functors of this queue without locking its functor queue
+	 * - size has to be exact after push/pop returned (used for wakeup of idle workers)
+	 * - queue level of push is ignored (tickets are counted before push on level 0)
+	 */
+	virtual bool isConcurrent(void){ return false; }
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif /* _SCHEDULER_THREADPOOL_H_ */
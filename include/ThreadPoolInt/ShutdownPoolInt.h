@@ -0,0 +1,70 @@
+/**
+ * @file   ShutdownPoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for controlled shutdown of the Threadpool
+ * 		Queued functors are handled (drain) or released (abort), all WorkerThreads
+ * 		are stopped at once and joined.
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _SHUTDOWN_THREADPOOL_H_
+#define _SHUTDOWN_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "BasePoolInt.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+/**
+ * shutdown modes
+ */
+#define TP_SHUTDOWN_Drain		0	///< handle all queued functors, wait for running ones
+#define TP_SHUTDOWN_DrainDeadline	1	///< handle queued functors until timeout, release the remaining ones
+#define TP_SHUTDOWN_Abort		2	///< release queued functors, wait for running ones (destructor)
+#define TP_SHUTDOWN_COUNT		3
+
+class ShutdownPoolInt {
+public:
+	ShutdownPoolInt(){};
+	virtual ~ShutdownPoolInt(){}
+
+	/**
+	 * stop pool: refuse new functors, handle/release queued ones, stop and join all WorkerThreads
+	 * - must not be called by a WorkerThread of the pool
+	 * @param mode		TP_SHUTDOWN_*
+	 * @param timeout_ms	drain time for TP_SHUTDOWN_DrainDeadline
+	 * @return count of released (unexecuted) functors
+	 */
+	virtual size_t shutdown(uint8_t mode = TP_SHUTDOWN_Drain, uint32_t timeout_ms = 0) = 0;
+
+	/**
+	 * check if shutdown was started
+	 */
+	virtual bool isShutdown(void) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif /* _SHUTDOWN_THREADPOOL_H_ */
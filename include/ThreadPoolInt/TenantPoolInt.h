@@ -0,0 +1,97 @@
+/**
+ * @file   TenantPoolInt.h
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  	Interface for the multi-tenant Threadpool extension
+ * 		Each tenant has an own sub queue with weight and queue limit. The sub queues
+ * 		(and the normal functor queue as tenant 0) are served by deficit round robin,
+ * 		so a flooding tenant only loses its own throughput.
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _TENANT_THREADPOOL_H_
+#define _TENANT_THREADPOOL_H_
+
+#include <icke2063_TP_config.h>
+
+#ifndef NO_TENANT_TP_SUPPORT
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "BasePoolInt.h"
+
+/**
+ * default queue limit of a tenant
+ */
+#ifndef TENANT_FUNCTOR_MAX
+	#define TENANT_FUNCTOR_MAX	FUNCTOR_MAX
+#endif
+
+/**
+ * tenant id of normal functor queue
+ */
+#define TP_TENANT_DEFAULT	0
+
+namespace icke2063 {
+namespace threadpool {
+
+///usage accounting of one tenant
+struct TenantStats {
+	uint32_t weight;		///< functors served per round
+	size_t queue_max;		///< queue limit
+	size_t queued;			///< currently queued functors
+	uint64_t submitted;		///< accepted functors
+	uint64_t rejected;		///< functors rejected by queue limit
+	uint64_t dispatched;		///< functors taken by WorkerThreads
+};
+
+class TenantPoolInt {
+public:
+	TenantPoolInt(){};
+	virtual ~TenantPoolInt(){}
+
+	/**
+	 * configure tenant (created on first use)
+	 * @param tenant_id	tenant (TP_TENANT_DEFAULT: weight of normal functor queue)
+	 * @param weight	functors served per round (>= 1)
+	 * @param queue_max	maximum count of queued functors of tenant
+	 * @return false on invalid parameter
+	 */
+	virtual bool setTenant(uint16_t tenant_id, uint32_t weight, size_t queue_max = TENANT_FUNCTOR_MAX) = 0;
+
+	/**
+	 * Add functor object to sub queue of tenant
+	 * MUST be implemented in inherit class (correct usage of locks, threads, ...)
+	 * @return		[success]: NULL
+	 * 			[failure]: FunctorInt* of given object (not added, not deleted)
+	 */
+	virtual FunctorInt *delegateTenantFunctor(FunctorInt *work, uint16_t tenant_id) = 0;
+
+	/**
+	 * get usage accounting of tenant
+	 * @return false if tenant is unknown
+	 */
+	virtual bool getTenantStats(uint16_t tenant_id, TenantStats &stats) = 0;
+};
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
+
+#endif
+#endif /* _TENANT_THREADPOOL_H_ */
@@ -30,6 +30,8 @@
 
 //C++11
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 #ifndef TP_OVERRIDE
 	#define TP_OVERRIDE override
@@ -37,6 +39,7 @@
 
 //common_cpp
 #include <ThreadPool.h>
+#include "Futex.h"
 
 //logging macros
 #ifndef WorkerThread_log_trace
@@ -56,6 +59,13 @@
 #endif
 
 
+/**
+ * maximum time to wait for running functors on fast shutdown (shared by all workers of a pool)
+ */
+#ifndef WORKER_FAST_SHUTDOWN_US
+	#define WORKER_FAST_SHUTDOWN_US 100000
+#endif
+
 #ifndef DEFAULT_WORKER_IDLE_US
 	#define DEFAULT_WORKER_IDLE_US 1000
 #endif
@@ -66,8 +76,18 @@ namespace threadpool {
 class WorkerThread: public WorkerThreadInt {
 	friend class ThreadPool;
 public:
+	/**
+	 * @param ref_pool		parent pool object
+	 * @param worker_idle_us	idle time of worker
+	 * @param worker_attr		creation attributes of worker thread (NULL: system defaults)
+	 * @param worker_index		index of worker within parent pool
+	 * @param reserved		worker of reserved high priority lane
+	 */
 	WorkerThread(BasePoolInt *ref_pool
-			, uint32_t worker_idle_us = DEFAULT_WORKER_IDLE_US);
+			, uint32_t worker_idle_us = DEFAULT_WORKER_IDLE_US
+			, const WorkerAttr *worker_attr = NULL
+			, uint16_t worker_index = 0
+			, bool reserved = false);
 
 	virtual ~WorkerThread();
 
@@ -96,6 +116,53 @@ public:
 	 */
 	bool wakeupWorker( void );
 
+	/**
+	 * signal worker thread to exit (without waiting)
+	 * - a fetched functor is handled before exit
+	 * - used to stop all workers of a pool at once before deleting them
+	 */
+	void stopWorker( void );
+
+	/**
+	 * wait for exit of worker thread function
+	 * @param deadline	absolute end of waiting (time_point::max(): wait forever)
+	 * @return true if worker thread function is finished
+	 */
+	bool waitFinished(std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * get index of this worker within parent pool
+	 */
+	uint16_t getWorkerIndex( void ){return m_worker_index;}
+
+	/**
+	 * check if worker belongs to reserved high priority lane
+	 */
+	bool isReserved( void ){return m_reserved;}
+
+	/**
+	 * get WorkerThread object of calling thread
+	 * @return NULL if calling thread is no WorkerThread
+	 */
+	static WorkerThread *getCurrentWorker( void ){return p_current_worker;}
+
+	/**
+	 * get stop token of ThreadPool of calling WorkerThread
+	 * @return token without state if calling thread is no WorkerThread
+	 */
+	static StopToken getCurrentStopToken( void );
+
+	/**
+	 * check if this worker belongs to given pool
+	 */
+	bool isWorkerOf(BasePoolInt *pool){return p_basepool == pool;}
+
+	/**
+	 * call functor_function of given functor and release (delete) it afterwards
+	 * - exceptions of functor_function are caught
+	 */
+	static void executeFunctor(FunctorInt *functor);
+
 private:
 
 	/**
@@ -104,12 +171,17 @@ private:
 	 * The current solution is to set a status value at each worker to let
 	 * the scheduler decide which worker can be destroyed.
 	 */
-	worker_status m_status;					//status of current thread
+	std::atomic<worker_status> m_status;			//status of current thread (read without lock by concurrent fetch)
 
 	virtual void worker_function( void ) TP_OVERRIDE;
 
 	static void* pthread_func(void * ptr);
 
+	/**
+	 * WorkerThread object of current thread
+	 */
+	static thread_local WorkerThread *p_current_worker;
+
   	/**
 	 * worker thread object
 	 */
@@ -120,6 +192,16 @@ private:
 	 */
 	pthread_cond_t m_worker_cond = PTHREAD_COND_INITIALIZER;
 
+	/**
+	 * mutex for condition and wakeup flag
+	 */
+	pthread_mutex_t m_worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+	/**
+	 * pending wakeup signal (no lost wakeup between idle check and wait)
+	 */
+	bool m_wakeup;
+
 	/**
 	 * running flag for worker thread
 	 *
@@ -127,9 +209,29 @@ private:
 	bool m_worker_running;
 
 	/**
-	 * flag for fast shutdown of this WorkerThread
+	 * end of waiting for finish by destructor (fast shutdown: shared deadline of all workers)
+	 */
+	std::chrono::steady_clock::time_point m_finish_deadline;
+
+	/**
+	 * futex word: set to 1 at exit of worker thread function
+	 */
+	std::atomic<int32_t> m_finished;
+
+	/**
+	 * index of this worker within parent pool
+	 */
+	uint16_t m_worker_index;
+
+	/**
+	 * worker of reserved high priority lane
+	 */
+	bool m_reserved;
+
+	/**
+	 * functors delegated to this worker (locked by m_functor_lock of pool)
 	 */
-	bool m_fast_shutdown;
+	std::deque<FunctorInt*> m_mailbox;
 
 	/**
 	 * reference to basepool object
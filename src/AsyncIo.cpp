@@ -0,0 +1,464 @@
+/**
+ * @file   AsyncIo.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  AsyncIo implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <sched.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+//common_cpp
+#include "../include/AsyncIo.h"
+
+#ifdef TP_IO_URING
+#include <sys/mman.h>
+#endif
+
+namespace icke2063 {
+namespace threadpool {
+
+AsyncIo::AsyncIo(ThreadPool *pool, uint32_t entries, bool emulation):
+#ifdef TP_IO_URING
+	m_ring_fd(-1),
+	p_sq_ptr(NULL), m_sq_size(0),
+	p_cq_ptr(NULL), m_cq_size(0),
+	p_sqes(NULL), m_sqes_size(0),
+	p_sq_head(NULL), p_sq_tail(NULL), m_sq_mask(0), p_sq_array(NULL), m_sq_entries(0),
+	p_cq_head(NULL), p_cq_tail(NULL), m_cq_mask(0), p_cqes(NULL),
+	m_prepared(0),
+	m_completion_thread(0),
+#endif
+	p_pool(pool),
+	m_emulated(true),
+	m_entries((entries > 0) ? entries : 1),
+	m_inflight(0),
+	m_emu_running(false)
+{
+#ifdef TP_IO_URING
+	if (!emulation && setupRing(m_entries))
+	{
+		if (0 == pthread_create(&m_completion_thread, NULL, pthread_completion, this))
+		{
+			m_emulated = false;
+		}
+		else
+		{
+			AsyncIo_log_error("AsyncIo: create completion thread failure\n");
+			m_completion_thread = 0;
+			closeRing();
+		}
+	}
+#else
+	(void)emulation;
+#endif
+
+	if (m_emulated)
+	{
+		AsyncIo_log_debug("AsyncIo[%p]: thread based emulation\n", (void*)this);
+		m_emu_running = true;
+		for (int i = 0; i < TP_ASYNCIO_EMU_THREADS; i++)
+		{
+			pthread_t thread;
+			if (0 == pthread_create(&thread, NULL, pthread_emulation, this))
+			{
+				m_emu_threads.push_back(thread);
+			}
+		}
+		if (m_emu_threads.empty())
+		{
+			AsyncIo_log_error("AsyncIo: create emulation thread failure\n");
+		}
+	}
+}
+
+AsyncIo::~AsyncIo()
+{
+#ifdef TP_IO_URING
+	if (!m_emulated)
+	{
+		// submit operations collected without flush (would never complete)
+		std::lock_guard<std::mutex> lock(m_submit_lock);
+		flushLocked();
+	}
+#endif
+
+	// wait for operations in flight (buffers/continuations of caller)
+	while (m_inflight.load(std::memory_order_acquire) > 0)
+	{
+		if (!(p_pool && p_pool->isWorkerThread() && p_pool->runPendingFunctor()))
+		{
+			usleep(1000);
+		}
+	}
+
+#ifdef TP_IO_URING
+	if (!m_emulated)
+	{
+		{
+			// stop marker: NOP without continuation
+			std::lock_guard<std::mutex> lock(m_submit_lock);
+			unsigned tail = *p_sq_tail;
+			unsigned index = tail & m_sq_mask;
+			struct io_uring_sqe *sqe = &((struct io_uring_sqe*)p_sqes)[index];
+
+			memset(sqe, 0, sizeof(*sqe));
+			sqe->opcode = IORING_OP_NOP;
+			sqe->user_data = 0;
+			p_sq_array[index] = index;
+			__atomic_store_n(p_sq_tail, tail + 1, __ATOMIC_RELEASE);
+			m_prepared++;
+			flushLocked();
+		}
+		pthread_join(m_completion_thread, NULL);
+		closeRing();
+	}
+#endif
+
+	{
+		std::lock_guard<std::mutex> lock(m_submit_lock);
+		m_emu_running = false;
+		m_emu_cond.notify_all();
+	}
+	for (size_t i = 0; i < m_emu_threads.size(); i++)
+	{
+		pthread_join(m_emu_threads[i], NULL);
+	}
+}
+
+FunctorInt *AsyncIo::read(int fd, void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush)
+{
+	return submit(false, fd, buffer, len, offset, continuation, flush);
+}
+
+FunctorInt *AsyncIo::write(int fd, const void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush)
+{
+	return submit(true, fd, const_cast<void*>(buffer), len, offset, continuation, flush);
+}
+
+FunctorInt *AsyncIo::submit(bool write, int fd, void *buffer, size_t len, off_t offset, AsyncIoFunctor *continuation, bool flush)
+{
+	if (continuation == NULL)
+	{
+		return continuation;
+	}
+
+	// limit operations in flight (completion ring cannot overflow)
+	if (m_inflight.fetch_add(1, std::memory_order_acq_rel) >= m_entries)
+	{
+		m_inflight.fetch_sub(1, std::memory_order_acq_rel);
+		AsyncIo_log_error("AsyncIo: too many operations in flight\n");
+		return continuation;
+	}
+
+	std::lock_guard<std::mutex> lock(m_submit_lock);
+
+#ifdef TP_IO_URING
+	if (!m_emulated)
+	{
+		unsigned tail = *p_sq_tail;
+		if (tail - __atomic_load_n(p_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries)
+		{
+			flushLocked();	// ring full of collected entries
+			if (tail - __atomic_load_n(p_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries)
+			{
+				m_inflight.fetch_sub(1, std::memory_order_acq_rel);
+				AsyncIo_log_error("AsyncIo: submission ring full\n");
+				return continuation;
+			}
+		}
+
+		unsigned index = tail & m_sq_mask;
+		struct io_uring_sqe *sqe = &((struct io_uring_sqe*)p_sqes)[index];
+
+		memset(sqe, 0, sizeof(*sqe));
+		sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+		sqe->fd = fd;
+		sqe->addr = (uint64_t)(uintptr_t)buffer;
+		sqe->len = (uint32_t)len;
+		sqe->off = (uint64_t)offset;
+		sqe->user_data = (uint64_t)(uintptr_t)continuation;
+		p_sq_array[index] = index;
+		__atomic_store_n(p_sq_tail, tail + 1, __ATOMIC_RELEASE);
+		m_prepared++;
+
+		if (flush)
+		{
+			flushLocked();
+		}
+		return NULL;
+	}
+#else
+	(void)flush;
+#endif
+
+	IoRequest request;
+	request.write = write;
+	request.fd = fd;
+	request.buffer = buffer;
+	request.len = len;
+	request.offset = offset;
+	request.continuation = continuation;
+	m_emu_queue.push_back(request);
+	m_emu_cond.notify_one();
+	return NULL;
+}
+
+void AsyncIo::flush(void)
+{
+#ifdef TP_IO_URING
+	if (!m_emulated)
+	{
+		std::lock_guard<std::mutex> lock(m_submit_lock);
+		flushLocked();
+	}
+#endif
+}
+
+void AsyncIo::complete(AsyncIoFunctor *continuation, int64_t result)
+{
+	continuation->setIoResult(result);
+
+	if (p_pool == NULL || p_pool->delegateFunctorWait(continuation) != NULL)
+	{
+		// pool not usable -> handle continuation within I/O thread
+		AsyncIo_log_error("AsyncIo: delegate failure -> run inline\n");
+		continuation->functor_execute();
+	}
+	m_inflight.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void AsyncIo::emulation_func(void)
+{
+	while (true)
+	{
+		IoRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_submit_lock);
+			while (m_emu_queue.empty() && m_emu_running)
+			{
+				m_emu_cond.wait(lock);
+			}
+			if (m_emu_queue.empty())
+			{
+				return;	// stopped
+			}
+			request = m_emu_queue.front();
+			m_emu_queue.pop_front();
+		}
+
+		ssize_t result;
+		do
+		{
+			result = request.write ? pwrite(request.fd, request.buffer, request.len, request.offset)
+					: pread(request.fd, request.buffer, request.len, request.offset);
+		} while (result < 0 && errno == EINTR);
+
+		complete(request.continuation, (result < 0) ? -errno : result);
+	}
+}
+
+void *AsyncIo::pthread_emulation(void *ptr)
+{
+	static_cast<AsyncIo*>(ptr)->emulation_func();
+	return NULL;
+}
+
+void *AsyncIo::pthread_completion(void *ptr)
+{
+#ifdef TP_IO_URING
+	static_cast<AsyncIo*>(ptr)->completion_func();
+#else
+	(void)ptr;
+#endif
+	return NULL;
+}
+
+#ifdef TP_IO_URING
+bool AsyncIo::setupRing(uint32_t entries)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+
+	m_ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if (m_ring_fd < 0)
+	{
+		AsyncIo_log_debug("AsyncIo: io_uring_setup failure: %i\n", errno);
+		return false;
+	}
+
+	// IORING_OP_READ/WRITE are supported by kernels with IORING_FEAT_FAST_POLL (5.7)
+	if (!(params.features & IORING_FEAT_FAST_POLL))
+	{
+		AsyncIo_log_debug("AsyncIo: io_uring without IORING_OP_READ/WRITE\n");
+		closeRing();
+		return false;
+	}
+
+	m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single_mmap)
+	{
+		m_sq_size = m_cq_size = (m_sq_size > m_cq_size) ? m_sq_size : m_cq_size;
+	}
+
+	p_sq_ptr = mmap(NULL, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+	if (p_sq_ptr == MAP_FAILED)
+	{
+		p_sq_ptr = NULL;
+		closeRing();
+		return false;
+	}
+
+	if (single_mmap)
+	{
+		p_cq_ptr = p_sq_ptr;
+	}
+	else
+	{
+		p_cq_ptr = mmap(NULL, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+		if (p_cq_ptr == MAP_FAILED)
+		{
+			p_cq_ptr = NULL;
+			closeRing();
+			return false;
+		}
+	}
+
+	m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	p_sqes = mmap(NULL, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+	if (p_sqes == MAP_FAILED)
+	{
+		p_sqes = NULL;
+		closeRing();
+		return false;
+	}
+
+	char *sq = (char*)p_sq_ptr;
+	p_sq_head = (unsigned*)(sq + params.sq_off.head);
+	p_sq_tail = (unsigned*)(sq + params.sq_off.tail);
+	m_sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+	p_sq_array = (unsigned*)(sq + params.sq_off.array);
+	m_sq_entries = params.sq_entries;
+
+	char *cq = (char*)p_cq_ptr;
+	p_cq_head = (unsigned*)(cq + params.cq_off.head);
+	p_cq_tail = (unsigned*)(cq + params.cq_off.tail);
+	m_cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+	p_cqes = cq + params.cq_off.cqes;
+
+	// completion ring has room for all operations in flight
+	if (m_entries > params.cq_entries)
+	{
+		m_entries = params.cq_entries;
+	}
+	return true;
+}
+
+void AsyncIo::closeRing(void)
+{
+	if (p_sqes)
+	{
+		munmap(p_sqes, m_sqes_size);
+		p_sqes = NULL;
+	}
+	if (p_cq_ptr && p_cq_ptr != p_sq_ptr)
+	{
+		munmap(p_cq_ptr, m_cq_size);
+	}
+	p_cq_ptr = NULL;
+	if (p_sq_ptr)
+	{
+		munmap(p_sq_ptr, m_sq_size);
+		p_sq_ptr = NULL;
+	}
+	if (m_ring_fd >= 0)
+	{
+		close(m_ring_fd);
+		m_ring_fd = -1;
+	}
+}
+
+void AsyncIo::flushLocked(void)
+{
+	while (m_prepared > 0)
+	{
+		int submitted = (int)syscall(__NR_io_uring_enter, m_ring_fd, m_prepared, 0, 0, NULL, 0);
+		if (submitted < 0)
+		{
+			if (errno == EINTR || errno == EAGAIN)
+			{
+				sched_yield();
+				continue;
+			}
+			AsyncIo_log_error("AsyncIo: io_uring_enter failure: %i\n", errno);
+			return;
+		}
+		m_prepared -= (unsigned)submitted;
+	}
+}
+
+void AsyncIo::completion_func(void)
+{
+	std::vector<std::pair<AsyncIoFunctor*, int64_t> > batch;
+	bool running = true;
+
+	batch.reserve(m_entries);
+	while (running)
+	{
+		if (syscall(__NR_io_uring_enter, m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0
+				&& errno != EINTR)
+		{
+			AsyncIo_log_error("AsyncIo: wait for completion failure: %i\n", errno);
+			usleep(1000);
+		}
+
+		// drain completion ring at once
+		unsigned head = *p_cq_head;
+		unsigned tail = __atomic_load_n(p_cq_tail, __ATOMIC_ACQUIRE);
+		while (head != tail)
+		{
+			struct io_uring_cqe *cqe = &((struct io_uring_cqe*)p_cqes)[head & m_cq_mask];
+			if (cqe->user_data == 0)
+			{
+				running = false;	// stop marker
+			}
+			else
+			{
+				batch.push_back(std::make_pair((AsyncIoFunctor*)(uintptr_t)cqe->user_data, (int64_t)cqe->res));
+			}
+			head++;
+		}
+		__atomic_store_n(p_cq_head, head, __ATOMIC_RELEASE);
+
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			complete(batch[i].first, batch[i].second);
+		}
+		batch.clear();
+	}
+}
+#endif
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
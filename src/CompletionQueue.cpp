@@ -0,0 +1,165 @@
+/**
+ * @file   CompletionQueue.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  CompletionQueue implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+//common_cpp
+#include "../include/CompletionQueue.h"
+#include "../include/WorkerThread.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+PostFunctor::PostFunctor(CompletionQueue *queue, FunctorInt *work, FunctorInt *completion):
+	p_queue(queue),
+	p_work(work),
+	p_completion(completion)
+{
+}
+
+PostFunctor::~PostFunctor()
+{
+	// removed unhandled from queue
+	if (p_work)
+	{
+		p_work->functor_release();
+	}
+	if (p_completion)
+	{
+		p_completion->functor_release();
+	}
+}
+
+void PostFunctor::functor_function(void)
+{
+	if (p_work)
+	{
+		FunctorInt *work = p_work;
+		p_work = NULL;
+		WorkerThread::executeFunctor(work);
+	}
+
+	if (p_completion && p_queue->post(p_completion) == NULL)
+	{
+		p_completion = NULL;
+	}
+}
+
+CompletionQueue::CompletionQueue():
+	m_event_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+	m_count(0)
+{
+	if (m_event_fd < 0)
+	{
+		CompletionQueue_log_error("CompletionQueue: eventfd failure: %i\n", errno);
+	}
+}
+
+CompletionQueue::~CompletionQueue()
+{
+	CompletionNode *node;
+
+	while (m_count.load(std::memory_order_acquire) > 0)
+	{
+		if ((node = m_queue.pop()) != NULL)
+		{
+			node->functor->functor_release();
+			delete node;
+			m_count.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	if (m_event_fd >= 0)
+	{
+		close(m_event_fd);
+		m_event_fd = -1;
+	}
+}
+
+void CompletionQueue::signal(void)
+{
+	uint64_t value = 1;
+	if (write(m_event_fd, &value, sizeof(value)) < 0)
+	{
+		CompletionQueue_log_error("CompletionQueue: signal failure: %i\n", errno);
+	}
+}
+
+FunctorInt *CompletionQueue::post(FunctorInt *functor)
+{
+	if (functor == NULL || m_event_fd < 0)
+	{
+		return functor;
+	}
+
+	CompletionNode *node = new CompletionNode;
+	node->functor = functor;
+	m_queue.push(node);
+
+	// first pending functor -> wakeup external event loop
+	if (m_count.fetch_add(1, std::memory_order_acq_rel) == 0)
+	{
+		signal();
+	}
+	return NULL;
+}
+
+size_t CompletionQueue::drain(size_t max_count)
+{
+	size_t count = 0;
+	uint64_t value;
+
+	// reset eventfd (readable again by next post to empty queue)
+	if (m_event_fd >= 0 && read(m_event_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+	{
+		CompletionQueue_log_error("CompletionQueue: read failure: %i\n", errno);
+	}
+
+	while (count < max_count && m_count.load(std::memory_order_acquire) > 0)
+	{
+		CompletionNode *node = m_queue.pop();
+		if (node == NULL)
+		{
+			break;	// producer did not finish push yet
+		}
+
+		FunctorInt *functor = node->functor;
+		delete node;
+		m_count.fetch_sub(1, std::memory_order_acq_rel);
+		WorkerThread::executeFunctor(functor);
+		count++;
+	}
+
+	// functors left (limit or unfinished push) -> no post will signal them
+	if (m_count.load(std::memory_order_acquire) > 0)
+	{
+		signal();
+	}
+	return count;
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
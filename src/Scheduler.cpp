@@ -0,0 +1,479 @@
+/**
+ * @file   Scheduler.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Queue disciplines implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+
+//common_cpp
+#include "../include/Scheduler.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+///names of createScheduler (default first)
+static const char *s_scheduler_names[] = {
+#ifndef NO_PRIORITY_TP_SUPPORT
+	"prio",
+#endif
+	"fifo",
+	"lifo",
+#ifndef NO_DEADLINE_TP_SUPPORT
+	"edf",
+#endif
+	"sharded",
+	NULL
+};
+
+/**
+ * get priority of functor (0 without PrioFunctorInt)
+ */
+static uint8_t getFunctorPriority(FunctorInt *work)
+{
+#ifndef NO_PRIORITY_TP_SUPPORT
+	PrioFunctorInt *prio_item = dynamic_cast<PrioFunctorInt*>(work);
+	return prio_item ? prio_item->getPriority() : 0;
+#else
+	(void)work;
+	return 0;
+#endif
+}
+
+/**
+ * get functor of queue element
+ */
+static FunctorInt *getEntryFunctor(FunctorInt *work)
+{
+	return work;
+}
+
+static FunctorInt *getEntryFunctor(const SchedulerEntry &entry)
+{
+	return entry.work;
+}
+
+/**
+ * find next functor with at least given priority (bounded scan from the front)
+ * - queue order may differ from priority (aging, FIFO/EDF order)
+ * @return end of queue if not found
+ */
+template <typename Queue>
+static typename Queue::iterator findMinPriority(Queue &queue, uint8_t min_priority)
+{
+	typename Queue::iterator queue_it = queue.begin();
+
+	if (min_priority == 0)
+	{
+		return queue_it;
+	}
+
+	for (size_t i = 0; queue_it != queue.end() && i < TP_RESERVED_SCAN; ++queue_it, i++)
+	{
+		if (getFunctorPriority(getEntryFunctor(*queue_it)) >= min_priority)
+		{
+			return queue_it;
+		}
+	}
+	return queue.end();
+}
+
+FunctorInt *DequeScheduler::pop(uint8_t min_priority)
+{
+	queue_type::iterator queue_it = findMinPriority(m_queue, min_priority);
+
+	if (queue_it == m_queue.end())
+	{
+		return NULL;
+	}
+
+	FunctorInt *functor = queue_it->work;
+	m_queue.erase(queue_it);
+	return functor;
+}
+
+FunctorInt *DequeScheduler::evict(uint8_t priority)
+{
+	if (m_queue.empty() || getFunctorPriority(m_queue.back().work) >= priority)
+	{
+		return NULL;
+	}
+
+	FunctorInt *functor = m_queue.back().work;
+	m_queue.pop_back();
+	return functor;
+}
+
+FunctorInt *DequeScheduler::popOldest(void)
+{
+	if (m_queue.empty())
+	{
+		return NULL;
+	}
+
+	queue_type::iterator oldest_it = m_queue.begin();
+	for (queue_type::iterator queue_it = m_queue.begin(); queue_it != m_queue.end(); ++queue_it)
+	{
+		if (queue_it->seq < oldest_it->seq)
+		{
+			oldest_it = queue_it;
+		}
+	}
+
+	FunctorInt *functor = oldest_it->work;
+	m_queue.erase(oldest_it);
+	return functor;
+}
+
+int DequeScheduler::getPos(FunctorInt *work)
+{
+	for (queue_type::iterator queue_it = m_queue.begin(); queue_it != m_queue.end(); ++queue_it)
+	{
+		if (queue_it->work == work)
+		{
+			return (int)(queue_it - m_queue.begin());
+		}
+	}
+	return -1;
+}
+
+uint8_t FifoScheduler::push(FunctorInt *work, uint8_t add_mode)
+{
+	if (add_mode == TP_SCHED_Front)
+	{
+		m_queue.push_front(newEntry(work));
+	}
+	else
+	{
+		m_queue.push_back(newEntry(work));
+	}
+	return 0;
+}
+
+uint8_t LifoScheduler::push(FunctorInt *work, uint8_t add_mode)
+{
+	(void)add_mode;
+	m_queue.push_front(newEntry(work));
+	return 0;
+}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+int64_t PrioScheduler::calcKey(uint8_t priority)
+{
+	if (m_aging_ms == 0)
+	{
+		return priority;
+	}
+
+	int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	return (int64_t)priority - now_ms / m_aging_ms;
+}
+
+uint8_t PrioScheduler::push(FunctorInt *work, uint8_t add_mode)
+{
+	PrioFunctorInt *param_item = dynamic_cast<PrioFunctorInt*>(work);
+
+	if (param_item == NULL)
+	{
+		m_queue.push_back(newEntry(work));
+		return 0;
+	}
+
+	int64_t key = calcKey(param_item->getPriority());
+
+	switch (add_mode)
+	{
+		case TP_SCHED_Front:
+		{
+			// keep queue sorted: at least key of current head
+			PrioFunctorInt *front_item = m_queue.empty() ? NULL : dynamic_cast<PrioFunctorInt*>(m_queue.front().work);
+			if (front_item && front_item->getPrioKey() > key)
+			{
+				key = front_item->getPrioKey();
+			}
+			param_item->setPrioKey(key);
+			m_queue.push_front(newEntry(work));
+		}
+		break;
+
+		case TP_SCHED_Back:
+		{
+			// keep queue sorted: at most key of current tail
+			PrioFunctorInt *back_item = m_queue.empty() ? NULL : dynamic_cast<PrioFunctorInt*>(m_queue.back().work);
+			if (back_item && back_item->getPrioKey() < key)
+			{
+				key = back_item->getPrioKey();
+			}
+			param_item->setPrioKey(key);
+			m_queue.push_back(newEntry(work));
+		}
+		break;
+
+		default:
+		{
+			param_item->setPrioKey(key);
+
+			// queue is sorted by key -> search from the back (equal keys stay in FIFO order)
+			queue_type::iterator queue_it = m_queue.end();
+			while (queue_it != m_queue.begin())
+			{
+				PrioFunctorInt *queue_item = dynamic_cast<PrioFunctorInt*>((queue_it - 1)->work);
+
+				if (queue_item == NULL || queue_item->getPrioKey() >= key)
+				{
+					break;
+				}
+				--queue_it;
+			}
+			m_queue.insert(queue_it, newEntry(work)); //insert behind last functor with higher or equal key
+		}
+		break;
+	}
+	return param_item->getPriority();
+}
+
+FunctorInt *PrioScheduler::evict(uint8_t priority)
+{
+	PrioFunctorInt *back_item = m_queue.empty() ? NULL : dynamic_cast<PrioFunctorInt*>(m_queue.back().work);
+
+	// only evict functor which would be handled after the new one
+	if (back_item == NULL || back_item->getPrioKey() >= calcKey(priority))
+	{
+		return NULL;
+	}
+
+	FunctorInt *functor = m_queue.back().work;
+	m_queue.pop_back();
+	return functor;
+}
+
+void PrioScheduler::setAging(uint32_t step_ms)
+{
+	if (step_ms == m_aging_ms)
+	{
+		return;
+	}
+	m_aging_ms = step_ms;
+
+	queue_type::iterator queue_it = m_queue.begin();
+	while (queue_it != m_queue.end())
+	{
+		PrioFunctorInt *queue_item = dynamic_cast<PrioFunctorInt*>(queue_it->work);
+		if (queue_item)
+		{
+			queue_item->setPrioKey(calcKey(queue_item->getPriority()));
+		}
+		++queue_it;
+	}
+	std::stable_sort(m_queue.begin(), m_queue.end(), [](const SchedulerEntry &a, const SchedulerEntry &b) {
+		PrioFunctorInt *prio_a = dynamic_cast<PrioFunctorInt*>(a.work);
+		PrioFunctorInt *prio_b = dynamic_cast<PrioFunctorInt*>(b.work);
+		return prio_a && prio_b && prio_a->getPrioKey() > prio_b->getPrioKey();
+	});
+}
+#endif
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+uint8_t EdfScheduler::push(FunctorInt *work, uint8_t add_mode)
+{
+	(void)add_mode;
+
+	// binary search behind last functor with earlier or equal deadline (equal deadlines stay in FIFO order)
+	m_queue.insert(std::upper_bound(m_queue.begin(), m_queue.end(), work, [](FunctorInt *a, const SchedulerEntry &b) {
+		DeadlineFunctorInt *deadline_a = dynamic_cast<DeadlineFunctorInt*>(a);
+		DeadlineFunctorInt *deadline_b = dynamic_cast<DeadlineFunctorInt*>(b.work);
+		// functors without deadline behind all others
+		return deadline_a && (!deadline_b || deadline_a->getDeadline() < deadline_b->getDeadline());
+	}), newEntry(work));
+	return 0;
+}
+#endif
+
+ShardedScheduler::ShardedScheduler(size_t shard_count):
+	m_shard_count(shard_count ? shard_count : TP_SHARD_COUNT),
+	p_shards(NULL),
+	m_count(0)
+{
+	p_shards = new Shard[m_shard_count];
+}
+
+ShardedScheduler::~ShardedScheduler()
+{
+	delete[] p_shards;
+}
+
+uint8_t ShardedScheduler::push(FunctorInt *work, uint8_t add_mode)
+{
+	// xorshift per thread (seeded by address of thread local variable)
+	static thread_local uint32_t s_seed = 0;
+	if (s_seed == 0)
+	{
+		s_seed = (uint32_t)(uintptr_t)&s_seed | 1;
+	}
+	s_seed ^= s_seed << 13;
+	s_seed ^= s_seed >> 17;
+	s_seed ^= s_seed << 5;
+
+	// power of two choices: shorter of two random shards
+	Shard *shard = &p_shards[s_seed % m_shard_count];
+	Shard *other = &p_shards[(s_seed >> 16) % m_shard_count];
+	if (other->count.load(std::memory_order_relaxed) < shard->count.load(std::memory_order_relaxed))
+	{
+		shard = other;
+	}
+
+	std::lock_guard<std::mutex> lock(shard->lock);
+	if (add_mode == TP_SCHED_Front)
+	{
+		shard->queue.push_front(work);
+	}
+	else
+	{
+		shard->queue.push_back(work);
+	}
+	// shard count before total count -> workers seeing the total find the shard filled
+	shard->count.fetch_add(1, std::memory_order_seq_cst);
+	m_count.fetch_add(1, std::memory_order_seq_cst);
+	return 0;
+}
+
+FunctorInt *ShardedScheduler::popShard(Shard &shard, uint8_t min_priority)
+{
+	if (shard.count.load(std::memory_order_seq_cst) == 0)
+	{
+		return NULL;	// no lock for empty shard
+	}
+
+	std::lock_guard<std::mutex> lock(shard.lock);
+	std::deque<FunctorInt *>::iterator queue_it = findMinPriority(shard.queue, min_priority);
+	if (queue_it == shard.queue.end())
+	{
+		return NULL;
+	}
+
+	FunctorInt *functor = *queue_it;
+	shard.queue.erase(queue_it);
+	shard.count.fetch_sub(1, std::memory_order_seq_cst);
+	m_count.fetch_sub(1, std::memory_order_seq_cst);
+	return functor;
+}
+
+FunctorInt *ShardedScheduler::popHome(uint8_t min_priority, size_t home)
+{
+	// home shard first, then scan the others
+	for (size_t i = 0; i < m_shard_count && m_count.load(std::memory_order_seq_cst) > 0; i++)
+	{
+		FunctorInt *functor = popShard(p_shards[(home + i) % m_shard_count], min_priority);
+		if (functor)
+		{
+			return functor;
+		}
+	}
+	return NULL;
+}
+
+FunctorInt *ShardedScheduler::evict(uint8_t priority)
+{
+	// tail of fullest shard
+	Shard *victim = NULL;
+	for (size_t i = 0; i < m_shard_count; i++)
+	{
+		if (victim == NULL || p_shards[i].count.load() > victim->count.load())
+		{
+			victim = &p_shards[i];
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(victim->lock);
+	if (victim->queue.empty() || getFunctorPriority(victim->queue.back()) >= priority)
+	{
+		return NULL;
+	}
+
+	FunctorInt *functor = victim->queue.back();
+	victim->queue.pop_back();
+	victim->count.fetch_sub(1, std::memory_order_seq_cst);
+	m_count.fetch_sub(1, std::memory_order_seq_cst);
+	return functor;
+}
+
+int ShardedScheduler::getPos(FunctorInt *work)
+{
+	for (size_t i = 0; i < m_shard_count; i++)
+	{
+		std::lock_guard<std::mutex> lock(p_shards[i].lock);
+		std::deque<FunctorInt *>::iterator queue_it = std::find(p_shards[i].queue.begin(), p_shards[i].queue.end(), work);
+		if (queue_it != p_shards[i].queue.end())
+		{
+			return (int)(queue_it - p_shards[i].queue.begin());
+		}
+	}
+	return -1;
+}
+
+SchedulerInt *createScheduler(const char *name)
+{
+	if (name == NULL)
+	{
+		name = s_scheduler_names[0];
+	}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+	if (strcmp(name, "prio") == 0)
+	{
+		return new PrioScheduler();
+	}
+#endif
+	if (strcmp(name, "fifo") == 0)
+	{
+		return new FifoScheduler();
+	}
+	if (strcmp(name, "lifo") == 0)
+	{
+		return new LifoScheduler();
+	}
+#ifndef NO_DEADLINE_TP_SUPPORT
+	if (strcmp(name, "edf") == 0)
+	{
+		return new EdfScheduler();
+	}
+#endif
+	if (strcmp(name, "sharded") == 0)
+	{
+		return new ShardedScheduler();
+	}
+	return NULL;
+}
+
+const char *getSchedulerName(size_t index)
+{
+	if (index >= sizeof(s_scheduler_names) / sizeof(s_scheduler_names[0]))
+	{
+		return NULL;
+	}
+	return s_scheduler_names[index];
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
@@ -0,0 +1,166 @@
+/**
+ * @file   StopToken.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  StopSource/StopToken/StopCallback implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <sched.h>
+
+//common_cpp
+#include "../include/StopToken.h"
+#include "../include/WorkerThread.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+namespace {
+
+///callback of linked source: forward stop request of parent
+class StopLinkFunctor: public FunctorInt {
+public:
+	StopLinkFunctor(StopState *state):p_state(state){};
+	virtual ~StopLinkFunctor(){};
+	virtual void functor_function(void) TP_OVERRIDE { p_state->requestStop(); }
+
+private:
+	///no reference count: link is removed by destructor of state
+	StopState *p_state;
+};
+
+} /* anonymous namespace */
+
+StopState::StopState():
+	m_stop_requested(false),
+	p_running(NULL),
+	m_running_thread(0),
+	p_link(NULL)
+{
+}
+
+StopState::~StopState()
+{
+	delete p_link;
+}
+
+bool StopState::requestStop(void)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	if (m_stop_requested.exchange(true, std::memory_order_acq_rel))
+	{
+		return false;
+	}
+
+	m_running_thread = pthread_self();
+	while (!m_callbacks.empty())
+	{
+		StopCallback *callback = m_callbacks.front();
+		m_callbacks.pop_front();
+		p_running = callback;
+		lock.unlock();
+
+		callback->p_callback->functor_function();
+		callback->m_done.store(true, std::memory_order_release); // callback may be gone afterwards
+
+		lock.lock();
+		p_running = NULL;
+	}
+	return true;
+}
+
+bool StopState::addCallback(StopCallback *callback)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_stop_requested.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	m_callbacks.push_back(callback);
+	return true;
+}
+
+void StopState::removeCallback(StopCallback *callback)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	if (p_running == callback && !pthread_equal(m_running_thread, pthread_self()))
+	{
+		// called right now by other thread -> wait for its end
+		lock.unlock();
+		while (!callback->m_done.load(std::memory_order_acquire))
+		{
+			sched_yield();
+		}
+		return;
+	}
+	m_callbacks.remove(callback);
+}
+
+StopSource::StopSource():
+	sp_state(new StopState())
+{
+}
+
+StopSource::StopSource(const StopToken &parent):
+	sp_state(new StopState())
+{
+	sp_state->p_link = new StopCallback(parent, new StopLinkFunctor(sp_state.get()));
+}
+
+StopCallback::StopCallback(const StopToken &token, FunctorInt *callback):
+	sp_state(token.sp_state),
+	p_callback(callback),
+	m_done(false)
+{
+	if (sp_state && p_callback && !sp_state->addCallback(this))
+	{
+		// stop requested before -> call now
+		p_callback->functor_function();
+		m_done.store(true, std::memory_order_release);
+		sp_state.reset();
+	}
+}
+
+StopCallback::~StopCallback()
+{
+	if (sp_state)
+	{
+		sp_state->removeCallback(this);
+	}
+	if (p_callback)
+	{
+		p_callback->functor_release();
+	}
+}
+
+StopToken StopFunctorInt::getStopToken(void)
+{
+	if (!m_stop_token.stopPossible())
+	{
+		// bind to pool executing this functor
+		m_stop_token = WorkerThread::getCurrentStopToken();
+	}
+	return m_stop_token;
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
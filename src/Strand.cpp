@@ -0,0 +1,158 @@
+/**
+ * @file   Strand.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  Strand implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <sched.h>
+
+//common_cpp
+#include "../include/Strand.h"
+#include "../include/WorkerThread.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+thread_local Strand *Strand::p_current_strand = NULL;
+
+Strand::Strand(ThreadPool *pool):
+	p_pool(pool),
+	m_count(0),
+	m_done(pool)
+{
+}
+
+Strand::~Strand()
+{
+	// wait until strand is not queued anymore
+	m_done.waitFor([this]() { return m_count.load(std::memory_order_acquire) == 0; });
+
+	// last handling thread may still wake us
+	m_done.drain();
+}
+
+bool Strand::countDone(void)
+{
+	if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		m_done.notify();
+		return true;
+	}
+	return false;
+}
+
+FunctorInt *Strand::post(FunctorInt *work)
+{
+	if (work == NULL)
+	{
+		return work;
+	}
+
+	StrandNode *node = new StrandNode;
+	node->functor = work;
+	m_queue.push(node);
+
+	// first pending functor -> strand has to be queued
+	if (m_count.fetch_add(1, std::memory_order_acq_rel) == 0)
+	{
+		schedule();
+	}
+	return NULL;
+}
+
+void Strand::schedule(void)
+{
+	if (p_pool && p_pool->delegateFunctor(this) == NULL)
+	{
+		return;
+	}
+
+	// pool not usable -> handle strand within calling thread
+	Strand_log_error("Strand[%p]: delegate failure -> run inline\n", (void*)this);
+	functor_function();
+}
+
+void Strand::functor_function(void)
+{
+	Strand *prev_strand = p_current_strand;
+
+	p_current_strand = this;
+	m_done.enter();
+	for (int i = 0; i < TP_STRAND_BATCH; i++)
+	{
+		StrandNode *node = m_queue.pop();
+
+		if (node == NULL)
+		{
+			// functor counted but not linked yet -> try again later instead of waiting
+			p_current_strand = prev_strand;
+			m_done.leave();
+			schedule();
+			return;
+		}
+
+		WorkerThread::executeFunctor(node->functor);
+		delete node;
+
+		if (countDone())
+		{
+			// queue empty -> no access to strand object anymore
+			p_current_strand = prev_strand;
+			m_done.leave();
+			return;
+		}
+	}
+
+	// batch limit reached -> give other functors a chance
+	p_current_strand = prev_strand;
+	m_done.leave();
+	schedule();
+}
+
+void Strand::functor_release(void)
+{
+	Strand_log_error("Strand[%p]: released by pool -> release pending functors\n", (void*)this);
+
+	m_done.enter();
+	for (;;)
+	{
+		StrandNode *node = m_queue.pop();
+
+		if (node == NULL)
+		{
+			sched_yield();	// producer between exchange and link
+			continue;
+		}
+
+		node->functor->functor_release();
+		delete node;
+
+		if (countDone())
+		{
+			// queue empty -> no access to strand object anymore
+			m_done.leave();
+			return;
+		}
+	}
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
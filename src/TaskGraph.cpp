@@ -0,0 +1,301 @@
+/**
+ * @file   TaskGraph.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  TaskGraph implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//generic
+#include <algorithm>
+
+//common_cpp
+#include "../include/TaskGraph.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+GraphNode::GraphNode(TaskGraph *graph, FunctorInt *functor):
+	p_graph(graph),
+	p_functor(functor),
+	m_pred_count(0),
+	m_pending_preds(0),
+	m_cancelled(false),
+	m_visit_epoch(0)
+{
+#ifndef NO_PRIORITY_TP_SUPPORT
+	PrioFunctorInt *prio_item = dynamic_cast<PrioFunctorInt*>(functor);
+	if (prio_item)
+	{
+		setPriority(prio_item->getPriority());
+	}
+#endif
+}
+
+GraphNode::~GraphNode()
+{
+	if (p_functor)
+	{
+		p_functor->functor_release();
+	}
+}
+
+void GraphNode::functor_function(void)
+{
+	GraphNode *node = this;
+
+	while (node)
+	{
+		GraphNode *next = NULL;
+
+		try
+		{
+			if (node->p_functor)
+			{
+				node->p_functor->functor_function();
+			}
+		}
+		catch (...)
+		{
+			TaskGraph_log_error("Exception in GraphNode[%p]\n", (void*)node);
+		}
+
+		std::vector<GraphNode*>::iterator succ_it = node->m_successors.begin();
+		while (succ_it != node->m_successors.end())
+		{
+			if ((*succ_it)->m_pending_preds.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				if ((*succ_it)->m_cancelled.load(std::memory_order_acquire))
+				{
+					(*succ_it)->cancel();	// other predecessor was cancelled
+				}
+				// last dependency completed -> first one stays on this worker
+				else if (next == NULL)
+				{
+					next = *succ_it;
+				}
+				else
+				{
+					p_graph->delegateNode(*succ_it);
+				}
+			}
+			++succ_it;
+		}
+
+		p_graph->nodeDone();	// no access to graph after completion of last node
+		node = next;
+	}
+}
+
+void GraphNode::cancel(void)
+{
+	std::vector<GraphNode*> stack;
+
+	stack.push_back(this);
+	while (!stack.empty())
+	{
+		GraphNode *node = stack.back();
+		stack.pop_back();
+
+		std::vector<GraphNode*>::iterator succ_it = node->m_successors.begin();
+		while (succ_it != node->m_successors.end())
+		{
+			(*succ_it)->m_cancelled.store(true, std::memory_order_release);
+			if ((*succ_it)->m_pending_preds.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				stack.push_back(*succ_it);
+			}
+			++succ_it;
+		}
+
+		TaskGraph_log_debug("TaskGraph[%p]: cancel node[%p]\n", (void*)node->p_graph, (void*)node);
+		node->p_graph->m_cancelled_count.fetch_add(1, std::memory_order_acq_rel);
+		node->p_graph->nodeDone();	// no access to graph after completion of last node
+	}
+}
+
+TaskGraph::TaskGraph(ThreadPool *pool):
+	p_pool(pool),
+	m_visit_epoch(0),
+	m_remaining(0),
+	m_done(pool),
+	m_cancelled_count(0)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+	wait();
+
+	// wait for last completion signal leaving this object
+	m_done.drain();
+
+	std::lock_guard<std::mutex> lock(m_graph_lock);
+	std::vector<GraphNode*>::iterator node_it = m_nodes.begin();
+	while (node_it != m_nodes.end())
+	{
+		delete *node_it;
+		++node_it;
+	}
+	m_nodes.clear();
+	m_roots.clear();
+}
+
+TaskGraph::node_id TaskGraph::addNode(FunctorInt *functor)
+{
+	std::lock_guard<std::mutex> lock(m_graph_lock);
+	GraphNode *node = new GraphNode(this, functor);
+
+	m_nodes.push_back(node);
+	m_roots.push_back(node);
+	return (node_id)(m_nodes.size() - 1);
+}
+
+bool TaskGraph::isReachable(GraphNode *start, GraphNode *succ)
+{
+	std::vector<GraphNode*> stack;
+
+	if (++m_visit_epoch == 0)
+	{
+		// epoch wrapped -> reset all marks
+		std::vector<GraphNode*>::iterator node_it = m_nodes.begin();
+		while (node_it != m_nodes.end())
+		{
+			(*node_it)->m_visit_epoch = 0;
+			++node_it;
+		}
+		m_visit_epoch = 1;
+	}
+
+	start->m_visit_epoch = m_visit_epoch;
+	stack.push_back(start);
+	while (!stack.empty())
+	{
+		GraphNode *node = stack.back();
+		stack.pop_back();
+
+		if (node == succ)
+		{
+			return true;
+		}
+
+		std::vector<GraphNode*>::iterator succ_it = node->m_successors.begin();
+		while (succ_it != node->m_successors.end())
+		{
+			// shared successor (diamond) -> visit only once
+			if ((*succ_it)->m_visit_epoch != m_visit_epoch)
+			{
+				(*succ_it)->m_visit_epoch = m_visit_epoch;
+				stack.push_back(*succ_it);
+			}
+			++succ_it;
+		}
+	}
+	return false;
+}
+
+bool TaskGraph::addEdge(node_id pred, node_id succ)
+{
+	std::lock_guard<std::mutex> lock(m_graph_lock);
+
+	if (pred >= m_nodes.size() || succ >= m_nodes.size() || pred == succ || isRunning())
+	{
+		return false;
+	}
+
+	GraphNode *pred_node = m_nodes[pred];
+	GraphNode *succ_node = m_nodes[succ];
+
+	// pred reachable from succ -> new edge creates cycle
+	if (isReachable(succ_node, pred_node))
+	{
+		TaskGraph_log_error("TaskGraph[%p]: edge %u -> %u creates cycle\n", (void*)this, pred, succ);
+		return false;
+	}
+
+	pred_node->m_successors.push_back(succ_node);
+	succ_node->m_pred_count++;
+
+	std::vector<GraphNode*>::iterator root_it = std::find(m_roots.begin(), m_roots.end(), succ_node);
+	if (root_it != m_roots.end())
+	{
+		m_roots.erase(root_it);
+	}
+	return true;
+}
+
+bool TaskGraph::submit(void)
+{
+	std::lock_guard<std::mutex> lock(m_graph_lock);
+
+	if (m_nodes.empty() || isRunning())
+	{
+		return false;
+	}
+
+	// reset dependency counters
+	std::vector<GraphNode*>::iterator node_it = m_nodes.begin();
+	while (node_it != m_nodes.end())
+	{
+		(*node_it)->m_pending_preds.store((*node_it)->m_pred_count, std::memory_order_relaxed);
+		(*node_it)->m_cancelled.store(false, std::memory_order_relaxed);
+		++node_it;
+	}
+	m_cancelled_count.store(0, std::memory_order_relaxed);
+	m_remaining.store((int32_t)m_nodes.size(), std::memory_order_release);
+
+	TaskGraph_log_debug("TaskGraph[%p]: submit %d nodes\n", (void*)this, (int)m_nodes.size());
+
+	node_it = m_roots.begin();
+	while (node_it != m_roots.end())
+	{
+		delegateNode(*node_it);
+		++node_it;
+	}
+	return true;
+}
+
+void TaskGraph::delegateNode(GraphNode *node)
+{
+	if (p_pool && p_pool->delegateFunctor(node) == NULL)
+	{
+		return;
+	}
+
+	// pool not usable -> handle node within calling thread
+	TaskGraph_log_error("TaskGraph[%p]: delegate failure -> run node inline\n", (void*)this);
+	node->functor_function();
+}
+
+void TaskGraph::nodeDone(void)
+{
+	m_done.enter();
+	if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		m_done.notify();
+	}
+	m_done.leave(); // last access to graph object
+}
+
+bool TaskGraph::wait(int32_t timeout_ms)
+{
+	return m_done.waitFor([this]() { return !isRunning(); }, timeout_ms);
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
@@ -0,0 +1,188 @@
+/**
+ * @file   TaskGroup.cpp
+ * @Author icke2063
+ * @date   19.10.2026
+ * @brief  TaskGroup implementation
+ *
+ * Copyright © 2026 icke2063 <icke2063@gmail.com>
+ *
+ * This software is free; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+//common_cpp
+#include "../include/TaskGroup.h"
+
+namespace icke2063 {
+namespace threadpool {
+
+GroupFunctor::GroupFunctor(TaskGroup *group, FunctorInt *functor):
+	p_group(group),
+	p_functor(functor)
+{
+#ifndef NO_PRIORITY_TP_SUPPORT
+	PrioFunctorInt *prio_item = dynamic_cast<PrioFunctorInt*>(functor);
+	if (prio_item)
+	{
+		setPriority(prio_item->getPriority());
+	}
+#endif
+}
+
+GroupFunctor::~GroupFunctor()
+{
+	if (p_functor)
+	{
+		p_functor->functor_release();
+	}
+	if (p_group)
+	{
+		p_group->functorDone();
+	}
+}
+
+void GroupFunctor::functor_function(void)
+{
+	if (!p_group->isCancelled())
+	{
+		p_functor->functor_function();
+	}
+}
+
+TaskGroup::TaskGroup(ThreadPool *pool):
+	p_pool(pool),
+	m_pending(0),
+	m_completed(0),
+	m_done(pool),
+	m_stop_source(pool ? pool->getStopToken() : StopToken())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+	waitAll();
+
+	// wait for last completion signal leaving this object
+	m_done.drain();
+}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+FunctorInt *TaskGroup::delegateFunctor(FunctorInt *work, uint8_t add_mode)
+#else
+FunctorInt *TaskGroup::delegateFunctor(FunctorInt *work)
+#endif
+{
+	GroupFunctor *group_functor;
+
+	if (work == NULL || p_pool == NULL || isCancelled())
+	{
+		return work;
+	}
+
+	StopFunctorInt *stop_item = dynamic_cast<StopFunctorInt*>(work);
+	if (stop_item && !stop_item->hasStopToken())
+	{
+		stop_item->setStopToken(getStopToken());
+	}
+
+	group_functor = new GroupFunctor(this, work);
+	addPending();
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+	if (p_pool->delegateFunctor(group_functor, add_mode) == NULL)
+#else
+	if (p_pool->delegateFunctor(group_functor) == NULL)
+#endif
+	{
+		return NULL;
+	}
+
+	TaskGroup_log_error("TaskGroup[%p]: delegate failure\n", (void*)this);
+
+	// not added -> undo without completion signal
+	group_functor->p_functor = NULL;
+	group_functor->p_group = NULL;
+	m_pending.fetch_sub(1, std::memory_order_acq_rel);
+	delete group_functor;
+	return work;
+}
+
+void TaskGroup::functorDone(void)
+{
+	m_done.enter();
+	m_completed.fetch_add(1, std::memory_order_acq_rel);
+	m_pending.fetch_sub(1, std::memory_order_acq_rel);
+	m_done.notify();
+	m_done.leave(); // last access to group object
+}
+
+namespace {
+
+struct AllDone {
+	std::atomic<int32_t> *p_pending;
+	bool operator()(void) { return p_pending->load(std::memory_order_acquire) == 0; }
+};
+
+struct AnyDone {
+	std::atomic<int32_t> *p_completed;
+	std::atomic<int32_t> *p_pending;
+	bool *p_taken;
+
+	bool takeCompleted(void) {
+		int32_t completed = p_completed->load(std::memory_order_acquire);
+		while (completed > 0)
+		{
+			if (p_completed->compare_exchange_weak(completed, completed - 1, std::memory_order_acq_rel))
+			{
+				*p_taken = true;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool operator()(void) {
+		if (takeCompleted())
+		{
+			return true;
+		}
+		if (p_pending->load(std::memory_order_acquire) != 0)
+		{
+			return false;
+		}
+		// nothing pending -> nothing to wait for (take completion counted meanwhile)
+		takeCompleted();
+		return true;
+	}
+};
+
+} /* anonymous namespace */
+
+bool TaskGroup::waitAll(int32_t timeout_ms)
+{
+	AllDone cond = { &m_pending };
+	return m_done.waitFor(cond, timeout_ms);
+}
+
+bool TaskGroup::waitAny(int32_t timeout_ms)
+{
+	bool taken = false;
+	AnyDone cond = { &m_completed, &m_pending, &taken };
+
+	m_done.waitFor(cond, timeout_ms);
+	return taken;
+}
+
+} /* namespace threadpool */
+} /* namespace icke2063 */
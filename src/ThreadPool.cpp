@@ -28,9 +28,15 @@
 #include <algorithm>
 #include <string>
 #include <stdexcept>
+#include <stdio.h>
+#include <chrono>
+
+#ifndef NO_REACTOR_TP_SUPPORT
+#include <sys/eventfd.h>
+#include <errno.h>
+#endif
 
 #ifndef NO_DELAYED_TP_SUPPORT
-#include <chrono>
 using namespace std::chrono;
 #endif
 
@@ -41,19 +47,84 @@ using namespace std::chrono;
 namespace icke2063 {
 namespace threadpool {
 
-ThreadPool::ThreadPool(uint8_t worker_count, bool auto_start):
+ThreadPool::ThreadPool(uint8_t worker_count, bool auto_start, const WorkerAttr *worker_attr, SchedulerInt *scheduler):
 #ifndef NO_DYNAMIC_TP_SUPPORT
 		DynamicPoolInt(worker_count, worker_count>1?true:false),
 #endif
-		m_pool_running(true)
+		m_mailbox_limit(TP_MAILBOX_MAX)
+		,m_mailbox_steal(TP_MAILBOX_STEAL)
+		,m_key_affinity(false)
+		,m_mailbox_queued(0)
+		,m_mailbox_fallback(0)
+		,m_mailbox_stolen(0)
+		,m_overload_policy(TP_OVERLOAD_Reject)
+		,p_overload_handler(NULL)
+		,m_overload_dropped(0)
+		,m_max_level(0)
+		,m_full_waiters(0)
+		,m_shutdown(false)
+		,m_blocked_count(0)
+		,m_compensating(0)
+		,m_worker_attr(worker_attr ? *worker_attr : WorkerAttr())
+		,m_reserved_count(0)
+		,m_lane_threshold(100)
+#ifndef NO_DEADLINE_TP_SUPPORT
+		,m_deadline_seq(0)
+		,m_deadline_queued(0)
+		,m_deadline_policy(TP_DEADLINE_Run)
+		,m_deadline_missed(0)
+		,m_deadline_dropped(0)
+		,m_deadline_stops_limit(DEADLINE_STOPS_PRUNE_MIN)
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+		,m_tenant_queued(0)
+#endif
+#ifndef NO_REACTOR_TP_SUPPORT
+		,m_epoll_fd(-1)
+		,m_wakeup_fd(-1)
+#endif
+		,m_pool_running(true)
 		,m_main_idle_us(DEFAULT_TP_MAINLOOP_IDLE_US)
 		,m_worker_idle_us(DEFAULT_WORKER_IDLE_US)
 
 {
 	int add_worker_count = 0;
 
+	p_scheduler = scheduler ? scheduler : createScheduler();
+
+	for (int i = 0; i < TP_OVERLOAD_COUNT; i++)
+	{
+		m_overload_count[i] = 0;
+	}
+	for (int i = 0; i < TP_QUEUE_LEVELS; i++)
+	{
+		m_level_enqueued[i] = 0;
+		m_level_dequeued[i] = 0;
+		m_level_evicted[i] = 0;
+		m_level_skipped[i] = 0;
+	}
+
 	ThreadPool_log_info("ThreadPool[%p]\n", (void*)this);
 
+#ifndef NO_REACTOR_TP_SUPPORT
+	m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_epoll_fd >= 0 && m_wakeup_fd >= 0)
+	{
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = m_wakeup_fd;
+		if (0 != epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &event))
+		{
+			ThreadPool_log_error("reactor: register wakeup failure: %i\n", errno);
+		}
+	}
+	else
+	{
+		ThreadPool_log_error("reactor: not usable -> sleeping pool loop\n");
+	}
+#endif
+
 
 	addWorker(); //add at least one worker thread failed -> threadpool not usable -> throw exception
 
@@ -64,6 +135,7 @@ ThreadPool::ThreadPool(uint8_t worker_count, bool auto_start):
 	}
 
 	if(m_workerThreads.size() < 1){
+		delete p_scheduler;
 		throw std::runtime_error("icke2063::ThreadPool: Cannot create Worker\n");
 	}
 
@@ -76,13 +148,22 @@ ThreadPool::ThreadPool(uint8_t worker_count, bool auto_start):
 
 ThreadPool::~ThreadPool() {
 	ThreadPool_log_info("~ThreadPool[%p]\n", (void*)this);
-	m_pool_running = false; //disable ThreadPool
 
-	if (id_main_thread > 0)
+	///ShutdownPoolInt (no effect if called before)
+	shutdown(TP_SHUTDOWN_Abort);
+
+#ifndef NO_REACTOR_TP_SUPPORT
+	if (m_epoll_fd >= 0)
 	{
-			pthread_join(id_main_thread, NULL);
-			id_main_thread = 0;
+		close(m_epoll_fd);
+		m_epoll_fd = -1;
+	}
+	if (m_wakeup_fd >= 0)
+	{
+		close(m_wakeup_fd);
+		m_wakeup_fd = -1;
 	}
+#endif
 
 #ifndef NO_DELAYED_TP_SUPPORT
 	///DelayedPoolInt
@@ -92,6 +173,18 @@ ThreadPool::~ThreadPool() {
 	///BasePoolInt
 	clearQueue();
 	clearWorker();
+	delete p_scheduler;
+	p_scheduler = NULL;
+
+#ifndef NO_TENANT_TP_SUPPORT
+	std::vector<Tenant*>::iterator tenant_it = m_tenants.begin();
+	while (tenant_it != m_tenants.end())
+	{
+		delete *tenant_it;
+		++tenant_it;
+	}
+	m_tenants.clear();
+#endif
 
 	ThreadPool_log_info("~~ThreadPool[%p]", (void*)this);
 }
@@ -129,14 +222,19 @@ void ThreadPool::main_thread_func(void){
     	  ThreadPool_log_trace("main_loop\n");
     	  main_loop();
       }
-      /**
-       * @todo replace simple wait by calculated timediff idletime - looptime
-       */
+#ifndef NO_REACTOR_TP_SUPPORT
+		// wait for ready file descriptors (or wakeup) instead of plain sleep
+		waitReactor(m_main_idle_us);
+#else
 		usleep(m_main_idle_us);
+#endif
     }
     main_past();
 }
 
+///pool whose main loop runs within calling thread
+static thread_local ThreadPool *s_loop_pool = NULL;
+
 void* ThreadPool::pthread_func(void * ptr)
 {
 	ThreadPool* p_self = dynamic_cast<ThreadPool*>((ThreadPool*)ptr);
@@ -145,6 +243,7 @@ void* ThreadPool::pthread_func(void * ptr)
 	{
 		return NULL;
 	}
+	s_loop_pool = p_self;
 
 	p_self->main_thread_func();
 
@@ -166,6 +265,13 @@ void ThreadPool::main_loop(void)
 #ifndef NO_DELAYED_TP_SUPPORT
 	checkDelayedQueue();
 #endif
+#ifndef NO_DEADLINE_TP_SUPPORT
+	checkDeadlineStops();
+#endif
+	if (m_compensating > 0)
+	{
+		retireCompensation();
+	}
 }
 
 void ThreadPool::main_past(void)
@@ -177,27 +283,104 @@ void ThreadPool::setTPMainLoopIdleTime(uint32_t main_idle_us)
 	m_main_idle_us = main_idle_us;
 }
 
+bool ThreadPool::setWorkerAttr(const WorkerAttr &worker_attr)
+{
+	bool result = true;
+	std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
+
+	m_worker_attr = worker_attr;
+
+	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+	while (workerThreads_it != m_workerThreads.end()) {
+		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+		if (tmpWorker && tmpWorker->id_worker_thread > 0)
+		{
+			int error = m_worker_attr.applyToThread(tmpWorker->id_worker_thread, tmpWorker->getWorkerIndex());
+			if (error != 0)
+			{
+				ThreadPool_log_error("setWorkerAttr: worker #%d failure: %i\n", (int)tmpWorker->getWorkerIndex(), error);
+				result = false;
+			}
+		}
+		++workerThreads_it;
+	}
+	return result;
+}
+
+WorkerAttr ThreadPool::getWorkerAttr(void)
+{
+	std::lock_guard<std::mutex> lock(m_worker_lock);
+	return m_worker_attr;
+}
+
+uint16_t ThreadPool::getFreeWorkerIndex(void)
+{
+	uint16_t index = 0;
+	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+	while (workerThreads_it != m_workerThreads.end()) {
+		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+		if (tmpWorker && tmpWorker->getWorkerIndex() == index)
+		{
+			//index in use -> restart search with next index
+			index++;
+			workerThreads_it = m_workerThreads.begin();
+			continue;
+		}
+		++workerThreads_it;
+	}
+	return index;
+}
+
 #ifndef NO_PRIORITY_TP_SUPPORT
 ///advanced implementation of default function
 FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work, uint8_t add_mode)
+{
+	FunctorInt *result = queueFunctor(work, add_mode);
+
+	if (result != NULL && add_mode != TPI_ADD_Deadline
+			&& m_pool_running && p_scheduler->size() >= FUNCTOR_MAX)
+	{
+		result = handleOverload(result, add_mode);
+	}
+	return result;
+}
+
+FunctorInt *ThreadPool::queueFunctor(FunctorInt *work, uint8_t add_mode)
 {
 	FunctorInt * result = work;
+	uint8_t priority = 0;
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+	if (add_mode == TPI_ADD_Deadline)
+	{
+		return delegateDeadlineFunctor(work);
+	}
+#endif
 
-	if (m_pool_running && (m_functor_queue.size() < FUNCTOR_MAX))
+	if (m_pool_running && (p_scheduler->size() < FUNCTOR_MAX))
 	{
-		ThreadPool_log_debug("add Functor #%i\n", (int)m_functor_queue.size() + 1);
+		ThreadPool_log_debug("add Functor #%i\n", (int)p_scheduler->size() + 1);
 		Functor *tmp_functor = dynamic_cast<Functor*>(work);
 		if (!tmp_functor)
 			return work;
 
+		// store priority before adding (functor may be handled and deleted immediately)
+		switch (add_mode)
+		{
+			case TPI_ADD_LiFo:	priority = 100; break;
+			case TPI_ADD_FiFo:	priority = 0; break;
+			default:		priority = tmp_functor->getPriority(); break;
+		}
+
 		switch (add_mode)
 		{
 			case TPI_ADD_LiFo:
 			{
 				ThreadPool_log_debug("TPI_ADD_LiFo\n");
 				tmp_functor->setPriority(100); //set highest priority to hold list in order
-				std::lock_guard<std::mutex> lock(m_functor_lock);
-				m_functor_queue.push_front(work);
+				pushFunctor(work, TP_SCHED_Front);
 				result = NULL;
 			}
 			break;
@@ -205,8 +388,7 @@ FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work, uint8_t add_mode)
 			{
 				ThreadPool_log_debug("TPI_ADD_FiFo\n");
 				tmp_functor->setPriority(0); //set lowest priority to hold list in order
-				std::lock_guard<std::mutex> lock(m_functor_lock);
-				m_functor_queue.push_back(work);
+				pushFunctor(work, TP_SCHED_Back);
 				result = NULL;
 			}
 			break;
@@ -220,11 +402,11 @@ FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work, uint8_t add_mode)
 
 	if(result == NULL)
 	{
-		wakeupWorker();
+		wakeupWorker(priority);
 	}
 	else
 	{
-		ThreadPool_log_error("failure add Functor #%i\n", (int)m_functor_queue.size() + 1);
+		ThreadPool_log_error("failure add Functor #%i\n", (int)p_scheduler->size() + 1);
 	}
 
 
@@ -233,10 +415,20 @@ FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work, uint8_t add_mode)
 #else
 FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work)
 {
-	if (m_pool_running && (m_functor_queue.size() < FUNCTOR_MAX))
+	FunctorInt *result = queueFunctor(work);
+
+	if (result != NULL && m_pool_running && p_scheduler->size() >= FUNCTOR_MAX)
 	{
-		std::lock_guard<std::mutex> lock(m_functor_lock);
-		m_functor_queue.push_back(work);
+		result = handleOverload(result);
+	}
+	return result;
+}
+
+FunctorInt *ThreadPool::queueFunctor(FunctorInt *work)
+{
+	if (m_pool_running && (p_scheduler->size() < FUNCTOR_MAX))
+	{
+		pushFunctor(work, TP_SCHED_Back);
 		wakeupWorker();
 		return NULL;
 	}
@@ -244,159 +436,1591 @@ FunctorInt *ThreadPool::delegateFunctor(FunctorInt *work)
 }
 #endif
 
-int ThreadPool::getQueuePos(FunctorInt *searchedFunctor)
+#ifndef NO_PRIORITY_TP_SUPPORT
+FunctorInt *ThreadPool::delegateFunctorWait(FunctorInt *work, int32_t timeout_ms, uint8_t add_mode)
+#else
+FunctorInt *ThreadPool::delegateFunctorWait(FunctorInt *work, int32_t timeout_ms)
+#endif
 {
-	int pos = -1;
-	std::lock_guard<std::mutex> lock(m_functor_lock); //lock functor list
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+	bool retried = false;
 
-	functor_queue_type::iterator queue_it = m_functor_queue.begin();
-	while (queue_it != m_functor_queue.end())
+	while (true)
 	{
-		pos++;	//raise
-		if (*queue_it == searchedFunctor)
+#ifndef NO_PRIORITY_TP_SUPPORT
+		if (queueFunctor(work, add_mode) == NULL)
+#else
+		if (queueFunctor(work) == NULL)
+#endif
 		{
-			//found matching reference -> exit function
-			return pos;
+			return NULL;
 		}
-		++queue_it;
-	}
 
-	return -1;
+		std::unique_lock<std::mutex> lock(m_functor_lock);
+
+		// count before size check -> concurrent pop (no lock) sees waiter or we see its free space
+		m_full_waiters.fetch_add(1, std::memory_order_seq_cst);
+		if (!m_pool_running || p_scheduler->size() < FUNCTOR_MAX)
+		{
+			m_full_waiters--;
+			if (m_pool_running && !retried)
+			{
+				retried = true;		// space freed since refusal (concurrent pop) -> try again
+				continue;
+			}
+			// not refused because of full queue -> waiting does not help
+			return work;
+		}
+		retried = false;
+
+		ThreadPool_log_trace("queue full -> wait for free space\n");
+		if (timeout_ms < 0)
+		{
+			m_not_full.wait(lock);
+		}
+		else if (m_not_full.wait_until(lock, deadline) == std::cv_status::timeout
+				&& p_scheduler->size() >= FUNCTOR_MAX)
+		{
+			m_full_waiters--;
+			return work;
+		}
+		m_full_waiters--;
+	}
 }
 
+bool ThreadPool::setOverloadPolicy(uint8_t policy, OverloadHandlerInt *handler)
+{
+	if (policy >= TP_OVERLOAD_COUNT || (policy == TP_OVERLOAD_Custom && handler == NULL))
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	p_overload_handler = handler;
+	m_overload_policy = policy;
+	return true;
+}
 
 #ifndef NO_PRIORITY_TP_SUPPORT
-FunctorInt *ThreadPool::delegatePrioFunctor(FunctorInt *work)
+FunctorInt *ThreadPool::handleOverload(FunctorInt *work, uint8_t add_mode)
+#else
+FunctorInt *ThreadPool::handleOverload(FunctorInt *work)
+#endif
 {
-  ThreadPool_log_debug("add priority Functor #%i\n", (int)m_functor_queue.size() + 1);
- 
-  std::lock_guard<std::mutex> lock(m_functor_lock);	//lock functor list
+	FunctorInt *victim = NULL;
+	OverloadHandlerInt *handler = NULL;
+	uint8_t policy = TP_OVERLOAD_Reject;
+
+	if (s_loop_pool == this)
+	{
+		// pool loop holds m_delayed_lock/m_reactor_lock -> functor is retried by next loop
+		ThreadPool_log_debug("overload: retry Functor[%p] by pool loop\n", (void*)work);
+		return work;
+	}
 
-  functor_queue_type::iterator queue_it = m_functor_queue.begin();
-	while (queue_it != m_functor_queue.end())
 	{
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		policy = m_overload_policy;
+		handler = p_overload_handler;
 
+		switch (policy)
 		{
-			PrioFunctorInt *queue_item = dynamic_cast<PrioFunctorInt*>(*queue_it);
-			PrioFunctorInt *param_item = dynamic_cast<PrioFunctorInt*>(work);
+			case TP_OVERLOAD_DropOldest:
+				victim = p_scheduler->popOldest();
+				if (victim)
+				{
+					countDequeue(victim);
+				}
+				break;
+#ifndef NO_PRIORITY_TP_SUPPORT
+			case TP_OVERLOAD_EvictLowest:
+			{
+				PrioFunctorInt *param_item = dynamic_cast<PrioFunctorInt*>(work);
+				uint8_t priority = 0;
+
+				switch (add_mode)
+				{
+					case TPI_ADD_LiFo:	priority = 100; break;
+					case TPI_ADD_FiFo:	priority = 0; break;
+					default:		priority = param_item ? param_item->getPriority() : 0; break;
+				}
 
-			if (queue_item && param_item) {
-				if (queue_item->getPriority() < param_item->getPriority()) {
-					m_functor_queue.insert(queue_it, work); //insert before
-					return NULL;
+				// only evict functor which would be handled after the new one
+				victim = p_scheduler->evict(priority);
+				if (victim)
+				{
+					countDequeue(victim, true);
 				}
 			}
+			break;
+#endif
+			default:
+				break;
 		}
-		++queue_it;
 	}
+	m_overload_count[policy]++;
 
-  ThreadPool_log_debug("push it at the end\n");
-  // not inserted yet -> push it at the end
-  m_functor_queue.push_back(work);
-  
-  return NULL;
-  }
+	switch (policy)
+	{
+		case TP_OVERLOAD_CallerRuns:
+			ThreadPool_log_debug("overload: caller runs Functor[%p]\n", (void*)work);
+			WorkerThread::executeFunctor(work);
+			return NULL;
+
+		case TP_OVERLOAD_DropOldest:
+		case TP_OVERLOAD_EvictLowest:
+			if (victim == NULL)
+			{
+				return work;
+			}
+			ThreadPool_log_debug("overload: release queued Functor[%p]\n", (void*)victim);
+			victim->functor_release();
+			m_overload_dropped++;
+#ifndef NO_PRIORITY_TP_SUPPORT
+			return queueFunctor(work, add_mode);
+#else
+			return queueFunctor(work);
 #endif
 
-bool ThreadPool::addWorker(void)
+		case TP_OVERLOAD_Custom:
+			return handler->handleOverload(work);
+
+		default:
+			ThreadPool_log_error("overload: reject Functor[%p]\n", (void*)work);
+			return work;
+	}
+}
+
+///ticket of last functor queued by calling thread
+static thread_local QueueTicket s_last_ticket;
+
+void ThreadPool::countEnqueue(FunctorInt *work, uint8_t level)
 {
-	if (m_pool_running && m_workerThreads.size() < WORKERTHREAD_MAX)
+#ifndef NO_PRIORITY_TP_SUPPORT
+	PrioFunctorInt *prio_item = dynamic_cast<PrioFunctorInt*>(work);
+	if (prio_item)
 	{
-		ThreadPool_log_debug("addworker[%p] #%d\n", (void*)this, (int)m_workerThreads.size() +1);
-		std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
-		try
-		{
-			WorkerThreadInt *newWorker = new WorkerThread(this, m_worker_idle_us);
-			m_workerThreads.push_back(newWorker);
-		} catch (std::exception& e)
-		{
-			ThreadPool_log_error("addworker: failure: %s\n",e.what());
-			return false;
-		}
-		return true;
+		prio_item->setQueueLevel(level);
 	}
-	return false;
+	else
+	{
+		level = 0;
+	}
+	if (level > m_max_level.load(std::memory_order_relaxed))
+	{
+		m_max_level.store(level, std::memory_order_relaxed);
+	}
+#else
+	(void)work;
+	level = 0;
+#endif
+	s_last_ticket.level = level;
+	s_last_ticket.evicted = m_level_evicted[level].load(std::memory_order_acquire);
+	s_last_ticket.seq = m_level_enqueued[level].fetch_add(1, std::memory_order_acq_rel);	// concurrent scheduler: no lock
+	s_last_ticket.valid = true;
+#ifndef NO_PRIORITY_TP_SUPPORT
+	if (prio_item)
+	{
+		prio_item->setQueueSeq(s_last_ticket.seq);
+	}
+#endif
 }
 
-bool ThreadPool::delWorker(void)
+void ThreadPool::countDequeue(FunctorInt *functor, bool evicted)
 {
-	WorkerThreadInt *deleteWorker = NULL;
-
-	if (m_pool_running)
+	uint8_t level = 0;
+#ifndef NO_PRIORITY_TP_SUPPORT
+	PrioFunctorInt *prio_item = dynamic_cast<PrioFunctorInt*>(functor);
+	if (prio_item)
 	{
-		std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker access
-		worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
-		while (workerThreads_it != m_workerThreads.end())
-		{
-			WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+		level = prio_item->getQueueLevel();
+	}
+#else
+	(void)functor;
+#endif
+	if (evicted)
+	{
+		// newest of its level -> gap behind all queued ones of the level
+		m_level_evicted[level].fetch_add(1, std::memory_order_release);
+		return;
+	}
 
-			if (tmpWorker && tmpWorker->getStatus() == WorkerThread::worker_idle)
-			{
-				deleteWorker = *workerThreads_it;
-				m_workerThreads.erase(workerThreads_it);
-				tmpWorker->resetBaseRef();
-				
-				break;
-			}
-			++workerThreads_it;
-		}
+#ifndef NO_PRIORITY_TP_SUPPORT
+	uint64_t skipped = m_level_skipped[level].load(std::memory_order_relaxed);
+	uint64_t pending = m_level_evicted[level].load(std::memory_order_relaxed) - skipped;
+	if (prio_item && pending > 0 && !p_scheduler->isConcurrent())
+	{
+		// skip sequence numbers of evicted functors before this one (FIFO within level)
+		uint64_t cursor = m_level_dequeued[level].load(std::memory_order_relaxed);
+		uint64_t skip = (prio_item->getQueueSeq() > cursor) ? std::min(prio_item->getQueueSeq() - cursor, pending) : 0;
+		m_level_skipped[level].store(skipped + skip, std::memory_order_release);
+		m_level_dequeued[level].store(cursor + skip + 1, std::memory_order_release);
+		return;
 	}
+#endif
+	m_level_dequeued[level].fetch_add(1, std::memory_order_release);
+}
 
-	if(deleteWorker)
+void ThreadPool::pushFunctor(FunctorInt *work, uint8_t sched_mode)
+{
+	if (p_scheduler->isConcurrent())
 	{
-		delete deleteWorker;
-		return true;
+		// count before push (functor may be handled and deleted immediately)
+		countEnqueue(work, 0);
+		p_scheduler->push(work, sched_mode);
+
+		// pairs with fence of fetchFunctor: either wakeupWorker finds the idle worker or the worker finds the functor
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return;
 	}
 
-	return false;
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	countEnqueue(work, p_scheduler->push(work, sched_mode));
 }
 
-void ThreadPool::wakeupWorker(void)
+#ifndef NO_PRIORITY_TP_SUPPORT
+FunctorInt *ThreadPool::delegateFunctorTicket(FunctorInt *work, QueueTicket &ticket, uint8_t add_mode)
+#else
+FunctorInt *ThreadPool::delegateFunctorTicket(FunctorInt *work, QueueTicket &ticket)
+#endif
 {
-	ThreadPool_log_debug("wakeupWorker[%p]\n", (void*)this);
-	std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
+	s_last_ticket.valid = false;
+#ifndef NO_PRIORITY_TP_SUPPORT
+	FunctorInt *result = delegateFunctor(work, add_mode);
+#else
+	FunctorInt *result = delegateFunctor(work);
+#endif
+	ticket = s_last_ticket;	// invalid if not queued within functor queue
+	return result;
+}
 
-	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
-	while (workerThreads_it != m_workerThreads.end()) {
-		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+bool ThreadPool::isStarted(const QueueTicket &ticket)
+{
+	return !ticket.valid || m_level_dequeued[ticket.level].load(std::memory_order_acquire) > ticket.seq;
+}
 
-		if (tmpWorker && tmpWorker->getStatus() == WorkerThread::worker_idle)
+int ThreadPool::getQueuePos(const QueueTicket &ticket)
+{
+	if (isStarted(ticket))
+	{
+		return -1;
+	}
+
+	// evicted functors before ticket not passed by dequeue cursor yet (passed in sequence order)
+	uint64_t skipped = m_level_skipped[ticket.level].load(std::memory_order_acquire);
+	uint64_t gaps = (ticket.evicted > skipped) ? ticket.evicted - skipped : 0;
+
+	int64_t pos = (int64_t)(ticket.seq - m_level_dequeued[ticket.level].load(std::memory_order_acquire) - gaps);
+	uint8_t max_level = m_max_level.load(std::memory_order_relaxed);
+
+	// functors of higher levels are handled first
+	for (int level = ticket.level + 1; level <= max_level; level++)
+	{
+		uint64_t dequeued = m_level_dequeued[level].load(std::memory_order_acquire)
+				+ m_level_evicted[level].load(std::memory_order_acquire)
+				- m_level_skipped[level].load(std::memory_order_acquire);
+		uint64_t enqueued = m_level_enqueued[level].load(std::memory_order_acquire);
+		if (enqueued > dequeued)
 		{
-			if( tmpWorker->wakeupWorker() );
-			return;
+			pos += (int64_t)(enqueued - dequeued);
 		}
-		++workerThreads_it;
 	}
+	return (pos >= 0) ? (int)pos : 0;
 }
 
-void ThreadPool::clearQueue(void)
+int ThreadPool::getQueuePos(FunctorInt *searchedFunctor)
 {
-	std::lock_guard<std::mutex> g(m_functor_lock);
+	std::lock_guard<std::mutex> lock(m_functor_lock); //lock functor list
+	return p_scheduler->getPos(searchedFunctor);
+}
 
-	functor_queue_type::iterator queue_it = m_functor_queue.begin();
-	while(queue_it != m_functor_queue.end())
-	{
-		delete *queue_it;
-		queue_it = m_functor_queue.erase(queue_it);
-	}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+void ThreadPool::setPrioAging(uint32_t step_ms)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);	//lock functor list
+	p_scheduler->setAging(step_ms);
 }
 
-void ThreadPool::clearWorker(void)
+FunctorInt *ThreadPool::delegatePrioFunctor(FunctorInt *work)
+{
+	ThreadPool_log_debug("add priority Functor #%i\n", (int)p_scheduler->size() + 1);
+	pushFunctor(work, TP_SCHED_Prio);
+	return NULL;
+}
+#endif
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+FunctorInt *ThreadPool::delegateDeadlineFunctor(FunctorInt *work)
 {
-	std::lock_guard<std::mutex> g(m_worker_lock);
+	DeadlineFunctorInt *deadline_item = dynamic_cast<DeadlineFunctorInt*>(work);
 
-	worker_list_type::iterator worker_it = m_workerThreads.begin();
-	while(worker_it != m_workerThreads.end())
+	if (!m_pool_running || deadline_item == NULL)
 	{
+		return work;
+	}
 
-		WorkerThread *worker = dynamic_cast<WorkerThread*>(*worker_it);
-		if(worker)
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock);	//lock functor list
+
+		if (m_deadline_queue.size() >= FUNCTOR_MAX)
 		{
-			worker->m_fast_shutdown = true;
+			ThreadPool_log_error("failure add deadline Functor #%i\n", (int)m_deadline_queue.size() + 1);
+			return work;
 		}
-		delete *worker_it;
-		worker_it = m_workerThreads.erase(worker_it);
-	}
+
+		DeadlineEntry entry;
+		entry.deadline = deadline_item->getDeadline();
+		entry.seq = m_deadline_seq++;
+		entry.functor = work;
+
+		m_deadline_queue.push_back(entry);
+		std::push_heap(m_deadline_queue.begin(), m_deadline_queue.end());
+		m_deadline_queued++;
+		ThreadPool_log_debug("add deadline Functor #%i\n", (int)m_deadline_queue.size());
+
+		// cancellable functor -> stop it when deadline is reached (also while running)
+		StopFunctorInt *stop_item = dynamic_cast<StopFunctorInt*>(work);
+		if (stop_item && entry.deadline != std::chrono::steady_clock::time_point::max())
+		{
+			DeadlineStop stop = { entry.deadline,
+					StopSource(stop_item->hasStopToken() ? stop_item->getStopToken() : getStopToken()) };
+
+			stop_item->setStopToken(stop.source.getToken());
+			if (m_deadline_stops.size() >= m_deadline_stops_limit)
+			{
+				pruneDeadlineStops();
+			}
+			m_deadline_stops.push_back(stop);
+			std::push_heap(m_deadline_stops.begin(), m_deadline_stops.end());
+		}
+	}
+
+	wakeupWorker();
+	return NULL;
+}
+
+void ThreadPool::checkDeadlineStops(void)
+{
+	std::vector<StopSource> reached;
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		while (!m_deadline_stops.empty() && m_deadline_stops.front().deadline <= now)
+		{
+			reached.push_back(m_deadline_stops.front().source);
+			std::pop_heap(m_deadline_stops.begin(), m_deadline_stops.end());
+			m_deadline_stops.pop_back();
+		}
+	}
+
+	// stop callbacks outside of pool locks
+	std::vector<StopSource>::iterator reached_it = reached.begin();
+	while (reached_it != reached.end())
+	{
+		reached_it->requestStop();
+		++reached_it;
+	}
+}
+
+void ThreadPool::pruneDeadlineStops(void)
+{
+	// functor released -> its token is gone and a stop request has no effect
+	m_deadline_stops.erase(std::remove_if(m_deadline_stops.begin(), m_deadline_stops.end(),
+			[](DeadlineStop &stop) { return !stop.source.hasTokens(); }), m_deadline_stops.end());
+	std::make_heap(m_deadline_stops.begin(), m_deadline_stops.end());
+
+	m_deadline_stops_limit = std::max((size_t)DEADLINE_STOPS_PRUNE_MIN, 2 * m_deadline_stops.size());
+	ThreadPool_log_debug("deadline stops pruned: %i left\n", (int)m_deadline_stops.size());
+}
+
+size_t ThreadPool::getDeadlineQueueCount(void)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	return m_deadline_queue.size();
+}
+
+size_t ThreadPool::getDeadlineStopCount(void)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	return m_deadline_stops.size();
+}
+
+void ThreadPool::setDeadlinePolicy(uint8_t policy)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	m_deadline_policy = policy;
+}
+
+void ThreadPool::handleExpiredFunctors(void)
+{
+	std::vector<FunctorInt*> expired;
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		expired.swap(m_expired_functors);
+	}
+
+	std::vector<FunctorInt*>::iterator expired_it = expired.begin();
+	while (expired_it != expired.end())
+	{
+		reportMissed(*expired_it);
+
+		ThreadPool_log_debug("drop expired Functor[%p]\n", (void*)*expired_it);
+		m_deadline_dropped++;
+		(*expired_it)->functor_release();
+		++expired_it;
+	}
+}
+
+void ThreadPool::reportMissed(FunctorInt *functor)
+{
+	DeadlineFunctorInt *deadline_item = dynamic_cast<DeadlineFunctorInt*>(functor);
+
+	try
+	{
+		deadline_item->deadline_missed();
+	}
+	catch (...)
+	{
+		ThreadPool_log_error("Exception in deadline_missed();\n");
+	}
+}
+#endif
+
+#ifndef NO_TENANT_TP_SUPPORT
+ThreadPool::Tenant *ThreadPool::getTenant(uint16_t tenant_id)
+{
+	if (tenant_id == TP_TENANT_DEFAULT)
+	{
+		return &m_default_tenant;
+	}
+
+	if (tenant_id >= m_tenants.size())
+	{
+		m_tenants.resize(tenant_id + 1, NULL);
+	}
+	if (m_tenants[tenant_id] == NULL)
+	{
+		m_tenants[tenant_id] = new Tenant();
+	}
+	return m_tenants[tenant_id];
+}
+
+bool ThreadPool::setTenant(uint16_t tenant_id, uint32_t weight, size_t queue_max)
+{
+	if (weight < 1)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	Tenant *tenant = getTenant(tenant_id);
+
+	tenant->stats.weight = weight;
+	tenant->stats.queue_max = (tenant_id == TP_TENANT_DEFAULT) ? FUNCTOR_MAX : queue_max;
+	return true;
+}
+
+void ThreadPool::activateTenant(Tenant *tenant)
+{
+	if (!tenant->active)
+	{
+		tenant->active = true;
+		tenant->deficit = 0;
+		m_active_tenants.push_back(tenant);
+	}
+
+	// normal functor queue takes part as long as any tenant is active
+	if (!m_default_tenant.active)
+	{
+		m_default_tenant.active = true;
+		m_default_tenant.deficit = 0;
+		m_active_tenants.push_back(&m_default_tenant);
+	}
+}
+
+FunctorInt *ThreadPool::delegateTenantFunctor(FunctorInt *work, uint16_t tenant_id)
+{
+	if (tenant_id == TP_TENANT_DEFAULT)
+	{
+		return delegateFunctor(work);
+	}
+
+	if (!m_pool_running || work == NULL)
+	{
+		return work;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		Tenant *tenant = getTenant(tenant_id);
+
+		if (tenant->queue.size() >= tenant->stats.queue_max)
+		{
+			// only this tenant is limited
+			tenant->stats.rejected++;
+			ThreadPool_log_debug("tenant %u: queue full\n", tenant_id);
+			return work;
+		}
+
+		tenant->queue.push_back(work);
+		tenant->stats.submitted++;
+		m_tenant_queued++;
+		activateTenant(tenant);
+	}
+
+	wakeupWorker();
+	return NULL;
+}
+
+bool ThreadPool::getTenantStats(uint16_t tenant_id, TenantStats &stats)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+
+	if (tenant_id == TP_TENANT_DEFAULT)
+	{
+		stats = m_default_tenant.stats;
+		stats.queued = p_scheduler->size();
+		return true;
+	}
+
+	if (tenant_id >= m_tenants.size() || m_tenants[tenant_id] == NULL)
+	{
+		return false;
+	}
+
+	stats = m_tenants[tenant_id]->stats;
+	stats.queued = m_tenants[tenant_id]->queue.size();
+	return true;
+}
+
+FunctorInt *ThreadPool::popTenantFunctor(void)
+{
+	while (!m_active_tenants.empty())
+	{
+		Tenant *tenant = m_active_tenants.front();
+
+		if (tenant->deficit <= 0)
+		{
+			// new round for this tenant -> back of list
+			tenant->deficit += tenant->stats.weight;
+			m_active_tenants.pop_front();
+			m_active_tenants.push_back(tenant);
+			continue;
+		}
+
+		if (tenant == &m_default_tenant)
+		{
+			if (p_scheduler->size() > 0)
+			{
+				tenant->deficit--;
+				return NULL;	// turn of normal functor queue
+			}
+
+			tenant->deficit = 0;
+			if (m_active_tenants.size() == 1)
+			{
+				// no tenant active anymore
+				tenant->active = false;
+				m_active_tenants.pop_front();
+			}
+			continue;
+		}
+
+		FunctorInt *functor = tenant->queue.front();
+		tenant->queue.pop_front();
+		tenant->deficit--;
+		tenant->stats.dispatched++;
+		m_tenant_queued--;
+
+		if (tenant->queue.empty())
+		{
+			tenant->active = false;
+			tenant->deficit = 0;
+			m_active_tenants.pop_front();
+		}
+		return functor;
+	}
+	return NULL;
+}
+#endif
+
+bool ThreadPool::addWorker(void)
+{
+	return addWorkerThread(NULL, false);
+}
+
+bool ThreadPool::addWorkerThread(const WorkerAttr *worker_attr, bool reserved)
+{
+	if (m_pool_running && m_workerThreads.size() < WORKERTHREAD_MAX)
+	{
+		ThreadPool_log_debug("addworker[%p] #%d\n", (void*)this, (int)m_workerThreads.size() +1);
+		std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
+		try
+		{
+			WorkerThreadInt *newWorker = new WorkerThread(this, m_worker_idle_us,
+					worker_attr ? worker_attr : &m_worker_attr, getFreeWorkerIndex(), reserved);
+			m_workerThreads.push_back(newWorker);
+			if (reserved)
+			{
+				m_reserved_count++;
+			}
+			else
+			{
+				addKeyWorker(dynamic_cast<WorkerThread*>(newWorker));
+			}
+		} catch (std::exception& e)
+		{
+			ThreadPool_log_error("addworker: failure: %s\n",e.what());
+			return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+bool ThreadPool::setReservedLane(uint8_t worker_count, uint8_t prio_threshold, const WorkerAttr *lane_attr)
+{
+	std::list<WorkerThreadInt*> oldWorkers;
+
+	{
+		std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
+		m_lane_threshold = (prio_threshold <= 100) ? prio_threshold : 100;
+
+		// remove all previous reserved workers
+		worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+		while (workerThreads_it != m_workerThreads.end())
+		{
+			WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+			if (tmpWorker && tmpWorker->isReserved())
+			{
+				// no resetBaseRef here: worker holds its pool_lock while fetching (lock order)
+				oldWorkers.push_back(tmpWorker);
+				workerThreads_it = m_workerThreads.erase(workerThreads_it);
+				m_reserved_count--;
+				continue;
+			}
+			++workerThreads_it;
+		}
+	}
+
+	// delete outside of lock -> destructor waits for running functor
+	while (!oldWorkers.empty())
+	{
+		delete oldWorkers.front();
+		oldWorkers.pop_front();
+	}
+
+	for (uint8_t i = 0; i < worker_count; i++)
+	{
+		if (!addWorkerThread(lane_attr, true))
+		{
+			ThreadPool_log_error("setReservedLane: cannot create reserved worker #%d\n", (int)i);
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+
+FunctorInt *ThreadPool::popFunctor(bool reserved, size_t home, bool &missed)
+{
+	FunctorInt *curFunctor = NULL;
+
+	missed = false;
+#ifndef NO_DEADLINE_TP_SUPPORT
+	if (!reserved && !m_deadline_queue.empty())
+	{
+		std::chrono::steady_clock::time_point tnow = std::chrono::steady_clock::now();
+
+		while (!m_deadline_queue.empty())
+		{
+			// earliest deadline first
+			std::pop_heap(m_deadline_queue.begin(), m_deadline_queue.end());
+			DeadlineEntry entry = m_deadline_queue.back();
+			m_deadline_queue.pop_back();
+			m_deadline_queued--;
+
+			if (entry.deadline < tnow)
+			{
+				m_deadline_missed++;
+				if (m_deadline_policy == TP_DEADLINE_Drop)
+				{
+					// callback and release outside of lock (batch)
+					m_expired_functors.push_back(entry.functor);
+					continue;
+				}
+				// callback by caller outside of lock, then handled like any other functor
+				missed = (m_deadline_policy == TP_DEADLINE_Report);
+			}
+			return entry.functor;
+		}
+	}
+#endif
+
+#ifndef NO_TENANT_TP_SUPPORT
+	if (!reserved && !m_active_tenants.empty())
+	{
+		curFunctor = popTenantFunctor();
+		if (curFunctor)
+		{
+			return curFunctor;
+		}
+	}
+#endif
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+	// reserved worker -> only take high priority functor
+	curFunctor = p_scheduler->popHome(reserved ? m_lane_threshold : 0, home);
+#else
+	curFunctor = p_scheduler->popHome(0, home);
+#endif
+	if (curFunctor)
+	{
+		countDequeue(curFunctor);
+
+		if (m_full_waiters > 0)
+		{
+			m_not_full.notify_one();	// free space for waiting producer
+		}
+	}
+	return curFunctor;
+}
+
+bool ThreadPool::hasPoolFunctors(void)
+{
+	size_t count = m_mailbox_queued.load(std::memory_order_relaxed);
+#ifndef NO_DEADLINE_TP_SUPPORT
+	count += m_deadline_queued.load(std::memory_order_relaxed);
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+	count += m_tenant_queued.load(std::memory_order_relaxed);
+#endif
+	return count > 0;
+}
+
+FunctorInt *ThreadPool::fetchFunctor(WorkerThread *worker)
+{
+	FunctorInt *curFunctor = NULL;
+	bool pool_checked = false;
+
+	// pool queues are not starved by a busy concurrent scheduler
+	if (p_scheduler->isConcurrent() && hasPoolFunctors())
+	{
+		curFunctor = fetchPoolFunctor(worker);
+		pool_checked = true;
+	}
+
+	if (curFunctor == NULL)
+	{
+		curFunctor = popConcurrentFunctor(worker);
+	}
+
+	if (curFunctor == NULL && !pool_checked)
+	{
+		curFunctor = fetchPoolFunctor(worker);
+	}
+
+	if (curFunctor == NULL && p_scheduler->isConcurrent())
+	{
+		// producers of concurrent scheduler do not lock: check again after idle status is visible
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		curFunctor = popConcurrentFunctor(worker);
+	}
+	return curFunctor;
+}
+
+FunctorInt *ThreadPool::popConcurrentFunctor(WorkerThread *worker)
+{
+	if (!p_scheduler->isConcurrent() || p_scheduler->size() == 0)
+	{
+		return NULL;
+	}
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+	// reserved worker -> only take high priority functor
+	FunctorInt *curFunctor = p_scheduler->popHome(worker->isReserved() ? m_lane_threshold : 0, worker->getWorkerIndex());
+#else
+	FunctorInt *curFunctor = p_scheduler->popHome(0, worker->getWorkerIndex());
+#endif
+	if (curFunctor)
+	{
+		countDequeue(curFunctor);
+
+		// size decremented before (seq_cst) -> no lost wakeup of producer counted before its size check
+		if (m_full_waiters.load(std::memory_order_seq_cst) > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_functor_lock);
+			m_not_full.notify_one();	// free space for waiting producer
+		}
+	}
+	return curFunctor;
+}
+
+FunctorInt *ThreadPool::fetchPoolFunctor(WorkerThread *worker)
+{
+	FunctorInt *curFunctor = NULL;
+	bool missed = false;
+#ifndef NO_DEADLINE_TP_SUPPORT
+	while (true)
+	{
+		bool expired = false;
+		{
+			std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
+
+			curFunctor = popWorkerFunctor(worker, missed);
+			expired = !m_expired_functors.empty();
+
+			if (curFunctor == NULL && !expired)
+			{
+				// set idle within locked queue -> no lost wakeup by delegating thread
+				worker->m_status = WorkerThread::worker_idle;
+				if (m_shutdown)
+				{
+					m_drained.notify_all();
+				}
+			}
+		}
+
+		if (expired)
+		{
+			handleExpiredFunctors();
+		}
+		if (missed)
+		{
+			reportMissed(curFunctor);
+		}
+		if (curFunctor || !expired)
+		{
+			return curFunctor;
+		}
+	}
+#else
+	std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
+
+	curFunctor = popWorkerFunctor(worker, missed);
+
+	if (curFunctor == NULL)
+	{
+		// set idle within locked queue -> no lost wakeup by delegating thread
+		worker->m_status = WorkerThread::worker_idle;
+		if (m_shutdown)
+		{
+			m_drained.notify_all();
+		}
+	}
+	return curFunctor;
+#endif
+}
+
+bool ThreadPool::runPendingFunctor(void)
+{
+	FunctorInt *curFunctor = NULL;
+	WorkerThread *worker = WorkerThread::getCurrentWorker();
+
+	bool expired = false;
+	bool missed = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
+		curFunctor = popWorkerFunctor((worker && worker->isWorkerOf(this)) ? worker : NULL, missed);
+#ifndef NO_DEADLINE_TP_SUPPORT
+		expired = !m_expired_functors.empty();
+#endif
+	}
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+	if (expired)
+	{
+		handleExpiredFunctors();
+	}
+	if (missed)
+	{
+		reportMissed(curFunctor);
+	}
+#endif
+
+	if (curFunctor == NULL)
+	{
+		return expired;
+	}
+
+	WorkerThread::executeFunctor(curFunctor);
+	return true;
+}
+
+bool ThreadPool::isWorkerThread(void)
+{
+	WorkerThread *worker = WorkerThread::getCurrentWorker();
+	return worker && worker->isWorkerOf(this);
+}
+
+bool ThreadPool::beginBlocking(void)
+{
+	if (!isWorkerThread())
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_blocking_lock);
+	m_blocked_count++;
+
+	size_t idle_count = 0;
+	size_t worker_count = 0;
+	{
+		std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+		worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+		while (workerThreads_it != m_workerThreads.end())
+		{
+			WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+			if (tmpWorker && !tmpWorker->isReserved())
+			{
+				worker_count++;
+				if (tmpWorker->getStatus() == WorkerThread::worker_idle)
+				{
+					idle_count++;
+				}
+			}
+			++workerThreads_it;
+		}
+	}
+
+	if (idle_count > 0)
+	{
+		// unpark idle worker
+		wakeupWorker();
+		return true;
+	}
+
+	size_t worker_max = WORKERTHREAD_MAX;
+#ifndef NO_DYNAMIC_TP_SUPPORT
+	if (isDynEnabled())
+	{
+		worker_max = getHighWatermark();
+	}
+#endif
+	if (worker_count < worker_max && addWorker())
+	{
+		m_compensating++;
+		ThreadPool_log_debug("compensating worker: %i (blocked: %i)\n", (int)m_compensating.load(), (int)m_blocked_count.load());
+	}
+	return true;
+}
+
+void ThreadPool::endBlocking(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_blocking_lock);
+		if (m_blocked_count > 0)
+		{
+			m_blocked_count--;
+		}
+	}
+	retireCompensation();
+}
+
+void ThreadPool::retireCompensation(void)
+{
+	size_t worker_min = 1;
+#ifndef NO_DYNAMIC_TP_SUPPORT
+	if (isDynEnabled())
+	{
+		worker_min = getLowWatermark();
+	}
+#endif
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_blocking_lock);
+
+			if (m_compensating <= m_blocked_count)
+			{
+				break;
+			}
+			if ((getWorkerCount() - m_reserved_count) <= worker_min)
+			{
+				// already removed by dynamic worker handling
+				m_compensating = m_blocked_count.load();
+				break;
+			}
+			m_compensating--;	// claim one retirement
+		}
+
+		// without blocking lock: deleted worker may enter/leave a blocking section before it stops
+		if (!delWorker())
+		{
+			m_compensating++;
+			break;	// no idle worker -> try again within pool loop
+		}
+	}
+}
+
+WorkerThread *ThreadPool::findWorker(uint16_t worker_index)
+{
+	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+	while (workerThreads_it != m_workerThreads.end())
+	{
+		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+		if (tmpWorker && !tmpWorker->isReserved() && tmpWorker->getWorkerIndex() == worker_index)
+		{
+			return tmpWorker;
+		}
+		++workerThreads_it;
+	}
+	return NULL;
+}
+
+WorkerThread *ThreadPool::findKeyWorker(uint64_t key)
+{
+	m_key_affinity = true;
+
+	if (m_key_workers.empty())
+	{
+		return NULL;
+	}
+
+	// jump consistent hash (Lamping, Veach)
+	int64_t bucket = -1;
+	int64_t jump = 0;
+	while (jump < (int64_t)m_key_workers.size())
+	{
+		bucket = jump;
+		key = key * 2862933555777941757ULL + 1;
+		jump = (int64_t)((bucket + 1) * (double(1LL << 31) / double((key >> 33) + 1)));
+	}
+	return m_key_workers[bucket];
+}
+
+void ThreadPool::addKeyWorker(WorkerThread *worker)
+{
+	if (worker)
+	{
+		// ordered by worker index -> new workers (highest index) get the new buckets
+		std::vector<WorkerThread*>::iterator pos_it = m_key_workers.begin();
+		while (pos_it != m_key_workers.end() && (*pos_it)->getWorkerIndex() < worker->getWorkerIndex())
+		{
+			++pos_it;
+		}
+		m_key_workers.insert(pos_it, worker);
+	}
+}
+
+void ThreadPool::removeKeyWorker(WorkerThread *worker)
+{
+	std::vector<WorkerThread*>::iterator pos_it = m_key_workers.begin();
+	while (pos_it != m_key_workers.end())
+	{
+		if (*pos_it == worker)
+		{
+			m_key_workers.erase(pos_it);
+			return;
+		}
+		++pos_it;
+	}
+}
+
+FunctorInt *ThreadPool::postMailbox(FunctorInt *work, WorkerThread *target)
+{
+	if (target->m_mailbox.size() >= m_mailbox_limit)
+	{
+		m_mailbox_fallback++;
+		return work;
+	}
+
+	target->m_mailbox.push_back(work);
+	m_mailbox_queued++;
+
+	if (target->getStatus() == WorkerThread::worker_idle)
+	{
+		target->wakeupWorker();
+	}
+	else if (m_mailbox_steal > 0 && target->m_mailbox.size() >= m_mailbox_steal)
+	{
+		wakeupWorker();		// let idle worker steal
+	}
+	return NULL;
+}
+
+FunctorInt *ThreadPool::delegateWorkerFunctor(FunctorInt *work, uint16_t worker_index)
+{
+	if (work == NULL || !m_pool_running)
+	{
+		return work;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
+		WorkerThread *target;
+		{
+			std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+			target = findWorker(worker_index);
+		}
+		// worker cannot be removed while m_functor_lock is locked (delWorker)
+		if (target == NULL)
+		{
+			return work;
+		}
+		if (postMailbox(work, target) == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	// mailbox full -> shared functor queue
+	return delegateFunctor(work);
+}
+
+FunctorInt *ThreadPool::delegateKeyFunctor(FunctorInt *work, uint64_t key)
+{
+	if (work == NULL || !m_pool_running)
+	{
+		return work;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
+		WorkerThread *target;
+		{
+			std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+			target = findKeyWorker(key);
+		}
+		if (target == NULL)
+		{
+			return work;
+		}
+		if (postMailbox(work, target) == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	// mailbox full -> shared functor queue
+	return delegateFunctor(work);
+}
+
+int ThreadPool::getKeyWorker(uint64_t key)
+{
+	std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+	WorkerThread *target = findKeyWorker(key);
+	return target ? target->getWorkerIndex() : -1;
+}
+
+int ThreadPool::getCurrentWorkerIndex(void)
+{
+	WorkerThread *worker = WorkerThread::getCurrentWorker();
+	return (worker && worker->isWorkerOf(this)) ? worker->getWorkerIndex() : -1;
+}
+
+void ThreadPool::setMailboxLimit(size_t limit, size_t steal_min)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	m_mailbox_limit = limit;
+	m_mailbox_steal = steal_min;
+}
+
+size_t ThreadPool::getMailboxCount(uint16_t worker_index)
+{
+	std::lock_guard<std::mutex> lock(m_functor_lock);
+	std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+	WorkerThread *worker = findWorker(worker_index);
+	return worker ? worker->m_mailbox.size() : 0;
+}
+
+FunctorInt *ThreadPool::popWorkerFunctor(WorkerThread *worker, bool &missed)
+{
+	FunctorInt *curFunctor = NULL;
+
+	missed = false;
+
+	// own mailbox first (worker affinity)
+	if (worker && !worker->m_mailbox.empty())
+	{
+		curFunctor = worker->m_mailbox.front();
+		worker->m_mailbox.pop_front();
+		m_mailbox_queued--;
+		return curFunctor;
+	}
+
+	curFunctor = popFunctor(worker && worker->isReserved(), worker ? worker->getWorkerIndex() : 0, missed);
+	if (curFunctor || m_mailbox_queued == 0 || m_mailbox_steal == 0 || (worker && worker->isReserved()))
+	{
+		return curFunctor;
+	}
+
+	// steal newest functor of fullest mailbox
+	std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+	WorkerThread *victim = NULL;
+	size_t victim_count = 0;
+	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+	while (workerThreads_it != m_workerThreads.end())
+	{
+		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+		if (tmpWorker && tmpWorker != worker && tmpWorker->m_mailbox.size() > victim_count)
+		{
+			victim = tmpWorker;
+			victim_count = tmpWorker->m_mailbox.size();
+		}
+		++workerThreads_it;
+	}
+
+	if (victim && victim_count >= m_mailbox_steal)
+	{
+		curFunctor = victim->m_mailbox.back();
+		victim->m_mailbox.pop_back();
+		m_mailbox_queued--;
+		m_mailbox_stolen++;
+	}
+	return curFunctor;
+}
+
+bool ThreadPool::delWorker(void)
+{
+	WorkerThreadInt *deleteWorker = NULL;
+	std::deque<FunctorInt*> mailbox;
+
+	if (m_pool_running)
+	{
+		std::lock_guard<std::mutex> queue_lock(m_functor_lock); // mailbox access (lock before worker lock)
+		std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker access
+		worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+		while (workerThreads_it != m_workerThreads.end())
+		{
+			WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+			// key affinity: only highest bucket is stable to remove (jump hash)
+			if (tmpWorker && !tmpWorker->isReserved()
+					&& (!m_key_affinity || tmpWorker == m_key_workers.back())
+					&& tmpWorker->getStatus() == WorkerThread::worker_idle)
+			{
+				deleteWorker = *workerThreads_it;
+				m_workerThreads.erase(workerThreads_it);
+				removeKeyWorker(tmpWorker);
+				// base reference is reset by destructor without pool locks (worker holds its pool_lock while fetching)
+
+				// functors posted after worker got idle
+				mailbox.swap(tmpWorker->m_mailbox);
+				m_mailbox_queued -= mailbox.size();
+				break;
+			}
+			++workerThreads_it;
+		}
+	}
+
+	if(deleteWorker)
+	{
+		delete deleteWorker;
+
+		// hand over mailbox to shared functor queue
+		std::deque<FunctorInt*>::iterator mailbox_it = mailbox.begin();
+		while (mailbox_it != mailbox.end())
+		{
+			if (delegateFunctor(*mailbox_it) != NULL)
+			{
+				(*mailbox_it)->functor_release();
+			}
+			++mailbox_it;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::wakeupWorker(uint8_t priority)
+{
+	WorkerThread *reservedWorker = NULL;
+
+	ThreadPool_log_debug("wakeupWorker[%p]\n", (void*)this);
+	std::lock_guard<std::mutex> lock(m_worker_lock); // lock before worker list access
+
+	worker_list_type::iterator workerThreads_it = m_workerThreads.begin();
+	while (workerThreads_it != m_workerThreads.end()) {
+		WorkerThread *tmpWorker = dynamic_cast<WorkerThread*>(*workerThreads_it);
+
+		if (tmpWorker && tmpWorker->getStatus() == WorkerThread::worker_idle)
+		{
+			if (!tmpWorker->isReserved())
+			{
+				tmpWorker->wakeupWorker();
+				return;
+			}
+			if (reservedWorker == NULL && priority >= m_lane_threshold)
+			{
+				reservedWorker = tmpWorker;
+			}
+		}
+		++workerThreads_it;
+	}
+
+	// no idle normal worker -> use reserved lane for high priority functor
+	if (reservedWorker)
+	{
+		reservedWorker->wakeupWorker();
+	}
+}
+
+void ThreadPool::clearQueue(void)
+{
+	functor_queue_type functors;
+
+	{
+		std::lock_guard<std::mutex> g(m_functor_lock);
+		takeQueued(functors);
+	}
+	releaseFunctors(functors);
+}
+
+size_t ThreadPool::takeQueued(functor_queue_type &functors)
+{
+	size_t taken = functors.size();
+
+	{
+		std::lock_guard<std::mutex> worker_lock(m_worker_lock);
+		worker_list_type::iterator worker_it = m_workerThreads.begin();
+		while (worker_it != m_workerThreads.end())
+		{
+			WorkerThread *worker = dynamic_cast<WorkerThread*>(*worker_it);
+			while (worker && !worker->m_mailbox.empty())
+			{
+				functors.push_back(worker->m_mailbox.front());
+				worker->m_mailbox.pop_front();
+			}
+			++worker_it;
+		}
+		m_mailbox_queued = 0;
+	}
+
+	FunctorInt *functor;
+	while ((functor = p_scheduler->pop(0)) != NULL)
+	{
+		countDequeue(functor);
+		functors.push_back(functor);
+	}
+	m_not_full.notify_all();
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+	std::vector<DeadlineEntry>::iterator deadline_it = m_deadline_queue.begin();
+	while(deadline_it != m_deadline_queue.end())
+	{
+		functors.push_back(deadline_it->functor);
+		++deadline_it;
+	}
+	m_deadline_queue.clear();
+	m_deadline_queued = 0;
+
+	std::vector<FunctorInt*>::iterator expired_it = m_expired_functors.begin();
+	while(expired_it != m_expired_functors.end())
+	{
+		functors.push_back(*expired_it);
+		++expired_it;
+	}
+	m_expired_functors.clear();
+#endif
+
+#ifndef NO_TENANT_TP_SUPPORT
+	std::vector<Tenant*>::iterator tenant_it = m_tenants.begin();
+	while(tenant_it != m_tenants.end())
+	{
+		if (*tenant_it)
+		{
+			functors.insert(functors.end(), (*tenant_it)->queue.begin(), (*tenant_it)->queue.end());
+			(*tenant_it)->queue.clear();
+			(*tenant_it)->active = false;
+		}
+		++tenant_it;
+	}
+	m_active_tenants.clear();
+	m_default_tenant.active = false;
+	m_tenant_queued = 0;
+#endif
+	return functors.size() - taken;
+}
+
+void ThreadPool::releaseFunctors(functor_queue_type &functors)
+{
+	functor_queue_type::iterator functor_it = functors.begin();
+	while (functor_it != functors.end())
+	{
+		(*functor_it)->functor_release();
+		++functor_it;
+	}
+	functors.clear();
+}
+
+size_t ThreadPool::getWorkerCount(void)
+{
+	std::lock_guard<std::mutex> lock(m_worker_lock);
+	return m_workerThreads.size();
+}
+
+size_t ThreadPool::getQueuedCount(void)
+{
+	size_t count = p_scheduler->size() + m_mailbox_queued;
+#ifndef NO_DEADLINE_TP_SUPPORT
+	count += m_deadline_queue.size() + m_expired_functors.size();
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+	count += m_tenant_queued;
+#endif
+	return count;
+}
+
+void ThreadPool::clearWorker(void)
+{
+	joinWorker(true);
+}
+
+void ThreadPool::joinWorker(bool fast_shutdown)
+{
+	worker_list_type workers;
+
+	{
+		// take workers out of list -> no worker lock while waiting for running functors
+		std::lock_guard<std::mutex> g(m_worker_lock);
+		workers.swap(m_workerThreads);
+		m_key_workers.clear();
+	}
+
+	// signal all workers at once (fast shutdown: one deadline for all running functors)
+	std::chrono::steady_clock::time_point finish_deadline = fast_shutdown ?
+			std::chrono::steady_clock::now() + std::chrono::microseconds(WORKER_FAST_SHUTDOWN_US)
+			: std::chrono::steady_clock::time_point::max();
+	worker_list_type::iterator worker_it = workers.begin();
+	while(worker_it != workers.end())
+	{
+		WorkerThread *worker = dynamic_cast<WorkerThread*>(*worker_it);
+		if(worker)
+		{
+			worker->m_finish_deadline = finish_deadline;
+			worker->stopWorker();
+		}
+		++worker_it;
+	}
+
+	{
+		// functors posted to mailboxes after last clear
+		functor_queue_type functors;
+		{
+			std::lock_guard<std::mutex> lock(m_functor_lock);
+			worker_it = workers.begin();
+			while(worker_it != workers.end())
+			{
+				WorkerThread *worker = dynamic_cast<WorkerThread*>(*worker_it);
+				while (worker && !worker->m_mailbox.empty())
+				{
+					functors.push_back(worker->m_mailbox.front());
+					worker->m_mailbox.pop_front();
+					m_mailbox_queued--;
+				}
+				++worker_it;
+			}
+		}
+		releaseFunctors(functors);
+	}
+
+	// workers are finishing concurrently -> join one after another (each waits until shared deadline at most)
+	worker_it = workers.begin();
+	while(worker_it != workers.end())
+	{
+		delete *worker_it;
+		worker_it = workers.erase(worker_it);
+	}
+}
+
+size_t ThreadPool::shutdown(uint8_t mode, uint32_t timeout_ms)
+{
+	size_t released = 0;
+	functor_queue_type functors;
+
+	if (mode >= TP_SHUTDOWN_COUNT || (mode != TP_SHUTDOWN_Abort && isWorkerThread()))
+	{
+		ThreadPool_log_error("shutdown: invalid mode %u or called by WorkerThread\n", (unsigned int)mode);
+		return 0;
+	}
+
+	if (m_shutdown.exchange(true))
+	{
+		return 0;	// already shut down
+	}
+
+	m_pool_running = false; //disable ThreadPool (refuse new functors, stop pool loop)
+
+	{
+		// release producers waiting for free queue space
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		m_not_full.notify_all();
+	}
+
+#ifndef NO_REACTOR_TP_SUPPORT
+	wakeupReactor();
+#endif
+
+	if (id_main_thread > 0)
+	{
+			pthread_join(id_main_thread, NULL);
+			id_main_thread = 0;
+	}
+
+#ifndef NO_DELAYED_TP_SUPPORT
+	{
+		delayed_list_type dfunctors;
+
+		{
+			// not due -> not handled anymore
+			std::lock_guard<std::mutex> g(m_delayed_lock);
+			dfunctors.swap(m_delayed_queue);
+		}
+		released += dfunctors.size();
+		releaseDelayedFunctors(dfunctors);
+	}
+#endif
+
+	{
+		std::unique_lock<std::mutex> lock(m_functor_lock);
+
+		if (mode != TP_SHUTDOWN_Abort)
+		{
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+					+ std::chrono::milliseconds(timeout_ms);
+
+			// woken by each WorkerThread which finds no functor
+			while (getQueuedCount() > 0 && getWorkerCount() > 0)
+			{
+				if (mode == TP_SHUTDOWN_Drain)
+				{
+					m_drained.wait(lock);
+				}
+				else if (m_drained.wait_until(lock, deadline) == std::cv_status::timeout)
+				{
+					break;
+				}
+			}
+		}
+		released += takeQueued(functors);
+	}
+	releaseFunctors(functors);
+
+	// let running functors return early (StopFunctorInt)
+	m_stop_source.requestStop();
+
+	joinWorker(mode != TP_SHUTDOWN_Drain);
+
+	{
+		// delegated by functors running while stopping
+		std::lock_guard<std::mutex> lock(m_functor_lock);
+		released += takeQueued(functors);
+	}
+	releaseFunctors(functors);
+
+	ThreadPool_log_info("shutdown[%p]: %u functors released\n", (void*)this, (unsigned int)released);
+	return released;
 }
 #ifndef NO_DYNAMIC_TP_SUPPORT
 void ThreadPool::handleWorkerCount(void)
@@ -407,14 +2031,14 @@ void ThreadPool::handleWorkerCount(void)
 		// check functor list
 		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
 
-		ThreadPool_log_trace("m_functor_queue.size(): %d\n", m_functor_queue.size());
+		ThreadPool_log_trace("queue size: %d\n", (int)p_scheduler->size());
 		ThreadPool_log_trace("m_workerThreads.size(): %d\n", m_workerThreads.size());
 		ThreadPool_log_trace("lowWatermark(): %d\n", getLowWatermark());
 		ThreadPool_log_trace("HighWatermark(): %d\n", getHighWatermark());
 		ThreadPool_log_trace("max_queue_size: %i\n", max_queue_size);
 	}
 	// add needed worker threads
-	while (getWorkerCount() < getLowWatermark())
+	while ((getWorkerCount() - m_reserved_count) < getLowWatermark())
 	{
 		//add new worker thread
 		ThreadPool_log_debug("try add worker\n");
@@ -429,9 +2053,17 @@ void ThreadPool::handleWorkerCount(void)
 	{
 		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
 
+		size_t queue_size = p_scheduler->size();
+#ifndef NO_DEADLINE_TP_SUPPORT
+		queue_size += m_deadline_queue.size();
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+		queue_size += m_tenant_queued;
+#endif
+
 		// add ondemand worker threads
-		if (m_functor_queue.size() > max_queue_size
-				&& getWorkerCount() < getHighWatermark())
+		if (queue_size > max_queue_size
+				&& (getWorkerCount() - m_reserved_count) < getHighWatermark())
 		{
 			//added new worker thread
 			if (addWorker())
@@ -443,9 +2075,17 @@ void ThreadPool::handleWorkerCount(void)
 
 	{
 		std::lock_guard<std::mutex> lock(m_functor_lock); // lock before queue access
-		//  try to remove worker threads
-		if (m_functor_queue.size() == 0
-				&& getWorkerCount() > getLowWatermark())
+		size_t queue_size = p_scheduler->size();
+#ifndef NO_DEADLINE_TP_SUPPORT
+		queue_size += m_deadline_queue.size();
+#endif
+#ifndef NO_TENANT_TP_SUPPORT
+		queue_size += m_tenant_queued;
+#endif
+
+		//  try to remove worker threads (compensating workers are retired by retireCompensation)
+		if (queue_size == 0
+				&& getWorkerCount() > m_reserved_count + m_compensating + getLowWatermark())
 		{
 			deleteWorker = true;
 		}
@@ -457,7 +2097,335 @@ void ThreadPool::handleWorkerCount(void)
 		delWorker();
 	}
 
-	max_queue_size = (1 << getWorkerCount()); //calc new maximum waiting functor count
+	max_queue_size = (1 << (getWorkerCount() - m_reserved_count)); //calc new maximum waiting functor count
+}
+#endif
+
+const cpu_set_t *WorkerAttr::getAffinity(uint16_t worker_index) const
+{
+	std::map<uint16_t, cpu_set_t>::const_iterator affinity_it = m_worker_affinity.find(worker_index);
+	if (affinity_it != m_worker_affinity.end())
+	{
+		return &affinity_it->second;
+	}
+	return m_affinity_set ? &m_affinity : NULL;
+}
+
+std::string WorkerAttr::getThreadName(uint16_t worker_index) const
+{
+	char name[16];	// pthread_setname_np: max. 16 bytes including terminating null byte
+
+	if (m_name.empty())
+	{
+		return std::string();
+	}
+	snprintf(name, sizeof(name), "%.9s-%u", m_name.c_str(), (unsigned int)worker_index);
+	return std::string(name);
+}
+
+int WorkerAttr::initPthreadAttr(pthread_attr_t *attr, uint16_t worker_index) const
+{
+	int result;
+	const cpu_set_t *cpuset = getAffinity(worker_index);
+
+	if ( 0 != (result = pthread_attr_init(attr)) )
+	{
+		return result;	// nothing to destroy
+	}
+
+	if (m_stack_size > 0)
+	{
+		size_t stack_size = (m_stack_size < (size_t)PTHREAD_STACK_MIN) ? (size_t)PTHREAD_STACK_MIN : m_stack_size;
+		if ( 0 != (result = pthread_attr_setstacksize(attr, stack_size)) )
+		{
+			pthread_attr_destroy(attr);
+			return result;
+		}
+	}
+
+	if (m_sched_policy >= 0)
+	{
+		struct sched_param param;
+		param.sched_priority = m_sched_priority;
+
+		if ( 0 != (result = pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED)) )
+		{
+			pthread_attr_destroy(attr);
+			return result;
+		}
+		if ( 0 != (result = pthread_attr_setschedpolicy(attr, m_sched_policy)) )
+		{
+			pthread_attr_destroy(attr);
+			return result;
+		}
+		if ( 0 != (result = pthread_attr_setschedparam(attr, &param)) )
+		{
+			pthread_attr_destroy(attr);
+			return result;
+		}
+	}
+
+	if (cpuset)
+	{
+		if ( 0 != (result = pthread_attr_setaffinity_np(attr, sizeof(cpu_set_t), cpuset)) )
+		{
+			pthread_attr_destroy(attr);
+			return result;
+		}
+	}
+	return 0;
+}
+
+int WorkerAttr::applyToThread(pthread_t thread, uint16_t worker_index) const
+{
+	int result;
+	const cpu_set_t *cpuset = getAffinity(worker_index);
+	std::string name = getThreadName(worker_index);
+
+	if (cpuset)
+	{
+		if ( 0 != (result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), cpuset)) )
+		{
+			return result;
+		}
+	}
+
+	if (m_sched_policy >= 0)
+	{
+		struct sched_param param;
+		param.sched_priority = m_sched_priority;
+		if ( 0 != (result = pthread_setschedparam(thread, m_sched_policy, &param)) )
+		{
+			return result;
+		}
+	}
+
+	if (!name.empty())
+	{
+		if ( 0 != (result = pthread_setname_np(thread, name.c_str())) )
+		{
+			return result;
+		}
+	}
+	return 0;
+}
+
+#ifndef NO_RATE_TP_SUPPORT
+bool ThreadPool::setRateLimit(uint16_t class_id, uint32_t rate, uint32_t burst)
+{
+	if (class_id >= TP_RATE_CLASS_MAX)
+	{
+		return false;
+	}
+
+	RateClass &rate_class = m_rate_classes[class_id];
+	rate_class.rate = rate;
+	rate_class.burst = (burst > 0) ? burst : 1;
+	rate_class.bucket.setRate(rate, burst);
+	return true;
+}
+
+FunctorInt *ThreadPool::delegateRateFunctor(FunctorInt *work, uint16_t class_id)
+{
+	if (work == NULL || class_id >= TP_RATE_CLASS_MAX)
+	{
+		return work;
+	}
+
+	RateClass &rate_class = m_rate_classes[class_id];
+	int64_t delay_ns = 0;
+
+	if (rate_class.bucket.isLimited())
+	{
+		int64_t now_ns = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		delay_ns = rate_class.bucket.reserve(now_ns);
+	}
+
+	if (delay_ns == 0)
+	{
+		// within budget
+		if (delegateFunctor(work) != NULL)
+		{
+			rate_class.bucket.cancel();
+			rate_class.rejected++;
+			return work;
+		}
+		rate_class.passed++;
+		return NULL;
+	}
+
+	// over budget -> park until reserved token is available
+	steady_clock::time_point deadline = steady_clock::now() + nanoseconds(delay_ns);
+	std::shared_ptr<DelayedFunctorInt> dfunctor(new DelayedFunctor(work, deadline));
+
+	if (delegateDelayedFunctor(dfunctor))
+	{
+		dfunctor->releaseFunctor();	// keep functor for caller
+		rate_class.bucket.cancel();
+		rate_class.rejected++;
+		return work;
+	}
+	rate_class.parked++;
+	ThreadPool_log_trace("rate class %d: park functor for %lld ns\n", class_id, (long long)delay_ns);
+	return NULL;
+}
+
+bool ThreadPool::getRateStats(uint16_t class_id, RateStats &stats)
+{
+	if (class_id >= TP_RATE_CLASS_MAX)
+	{
+		return false;
+	}
+
+	RateClass &rate_class = m_rate_classes[class_id];
+	stats.rate = rate_class.rate;
+	stats.burst = rate_class.burst;
+	stats.passed = rate_class.passed;
+	stats.parked = rate_class.parked;
+	stats.rejected = rate_class.rejected;
+	return true;
+}
+#endif
+
+#ifndef NO_REACTOR_TP_SUPPORT
+bool ThreadPool::registerFd(int fd, uint32_t events, FunctorInt *handler)
+{
+	IoFunctorInt *io_handler = dynamic_cast<IoFunctorInt*>(handler);
+
+	if (fd < 0 || io_handler == NULL || m_epoll_fd < 0)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_reactor_lock);
+	if (m_io_handlers.find(fd) != m_io_handlers.end())
+	{
+		return false;	// already registered
+	}
+
+	io_handler->setRegistration(fd, handler);
+
+	struct epoll_event event;
+	event.events = events | EPOLLET;
+	event.data.fd = fd;
+	if (0 != epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event))
+	{
+		ThreadPool_log_error("registerFd(%d): failure: %i\n", fd, errno);
+		io_handler->setRegistration(-1, NULL);
+		return false;
+	}
+	m_io_handlers[fd] = io_handler;
+	return true;
+}
+
+bool ThreadPool::unregisterFd(int fd)
+{
+	std::lock_guard<std::mutex> lock(m_reactor_lock);
+
+	std::map<int, IoFunctorInt*>::iterator handler_it = m_io_handlers.find(fd);
+	if (handler_it == m_io_handlers.end())
+	{
+		return false;
+	}
+
+	IoFunctorInt *io_handler = handler_it->second;
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+	m_io_handlers.erase(handler_it);
+
+	// handler waiting for free queue space is not delegated anymore
+	std::vector<IoFunctorInt*>::iterator retry_it = m_io_retry.begin();
+	while (retry_it != m_io_retry.end())
+	{
+		if (*retry_it == io_handler)
+		{
+			retry_it = m_io_retry.erase(retry_it);
+			io_handler->cancelReady();	// not queued
+			continue;
+		}
+		++retry_it;
+	}
+	io_handler->setRegistration(-1, NULL);
+	return true;
+}
+
+void ThreadPool::wakeupReactor(void)
+{
+	if (m_wakeup_fd >= 0)
+	{
+		uint64_t value = 1;
+		if (write(m_wakeup_fd, &value, sizeof(value)) < 0)
+		{
+			ThreadPool_log_trace("wakeupReactor: %i\n", errno);	// counter full -> wakeup pending anyway
+		}
+	}
+}
+
+void ThreadPool::waitReactor(uint32_t timeout_us)
+{
+	if (m_epoll_fd < 0)
+	{
+		usleep(timeout_us);
+		return;
+	}
+
+	struct epoll_event events[TP_REACTOR_EVENTS];
+	int timeout_ms = (int)((timeout_us + 999) / 1000);
+
+	{
+		std::lock_guard<std::mutex> lock(m_reactor_lock);
+		if (!m_io_retry.empty())
+		{
+			timeout_ms = 0;		// handlers waiting for free queue space
+		}
+	}
+
+	int count = epoll_wait(m_epoll_fd, events, TP_REACTOR_EVENTS, timeout_ms);
+	if (count < 0 && errno != EINTR)
+	{
+		ThreadPool_log_error("waitReactor: failure: %i\n", errno);
+		usleep(timeout_us);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_reactor_lock);
+
+	// handlers not accepted within last loop
+	std::vector<IoFunctorInt*> retry;
+	retry.swap(m_io_retry);
+	std::vector<IoFunctorInt*>::iterator retry_it = retry.begin();
+	while (retry_it != retry.end())
+	{
+		if (delegateFunctor((*retry_it)->getFunctor()) != NULL)
+		{
+			m_io_retry.push_back(*retry_it);
+		}
+		++retry_it;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (events[i].data.fd == m_wakeup_fd)
+		{
+			uint64_t value;
+			while (read(m_wakeup_fd, &value, sizeof(value)) > 0) {}
+			continue;
+		}
+
+		// handler may be unregistered since epoll_wait
+		std::map<int, IoFunctorInt*>::iterator handler_it = m_io_handlers.find(events[i].data.fd);
+		if (handler_it == m_io_handlers.end())
+		{
+			continue;
+		}
+
+		IoFunctorInt *io_handler = handler_it->second;
+		if (io_handler->addReadyEvents(events[i].events)
+				&& delegateFunctor(io_handler->getFunctor()) != NULL)
+		{
+			ThreadPool_log_debug("waitReactor: queue full -> retry fd %d\n", events[i].data.fd);
+			m_io_retry.push_back(io_handler);
+		}
+	}
 }
 #endif
 
@@ -477,8 +2445,6 @@ void DelayedFunctor::resetFunctor(FunctorInt *functor)
 
 void ThreadPool::checkDelayedQueue(void)
 {
-    long msec;
-
 	std::lock_guard<std::mutex> lock(m_delayed_lock);		//lock
 	  
 	  ThreadPool_log_trace("m_delayed_queue.size():%d\n",m_delayed_queue.size());
@@ -488,10 +2454,8 @@ void ThreadPool::checkDelayedQueue(void)
 	  delayed_list_type::iterator delayed_it = m_delayed_queue.begin();
 	  while(delayed_it != m_delayed_queue.end())
 	  {
-		  msec = (std::chrono::duration<float> (
-				  tnow-(*delayed_it)->getDeadline())).count();
-
-	    if(msec >= 0){
+	    // compare time points (sub second delays)
+	    if(tnow >= (*delayed_it)->getDeadline()){
 
 	    	FunctorInt *p_tmp_Functor = (*delayed_it)->releaseFunctor();
 	      // add current functor to queue
@@ -515,8 +2479,29 @@ void ThreadPool::checkDelayedQueue(void)
 
 void ThreadPool::clearDelayedList( void )
 {
-	std::lock_guard<std::mutex> g(m_delayed_lock);
-	m_delayed_queue.clear();
+	delayed_list_type dfunctors;
+
+	{
+		std::lock_guard<std::mutex> g(m_delayed_lock);
+		dfunctors.swap(m_delayed_queue);
+	}
+	releaseDelayedFunctors(dfunctors);
+}
+
+void ThreadPool::releaseDelayedFunctors(delayed_list_type &dfunctors)
+{
+	delayed_list_type::iterator delayed_it = dfunctors.begin();
+	while (delayed_it != dfunctors.end())
+	{
+		// entry may still be referenced by caller -> take functor out of it
+		FunctorInt *p_tmp_Functor = (*delayed_it)->releaseFunctor();
+		if (p_tmp_Functor != NULL)
+		{
+			p_tmp_Functor->functor_release();
+		}
+		++delayed_it;
+	}
+	dfunctors.clear();
 }
 
 
@@ -23,58 +23,81 @@
 
 #include "WorkerThread.h"
 
+#include <stdexcept>
+
 namespace icke2063 {
 namespace threadpool {
 
-WorkerThread::WorkerThread(BasePoolInt *ref_pool, uint32_t worker_idle_us):
+thread_local WorkerThread *WorkerThread::p_current_worker = NULL;
+
+WorkerThread::WorkerThread(BasePoolInt *ref_pool, uint32_t worker_idle_us,
+		const WorkerAttr *worker_attr, uint16_t worker_index, bool reserved):
 	m_status(worker_idle),
+	m_wakeup(false),
 	m_worker_running(true),
-	m_fast_shutdown(false),
+	m_finish_deadline(std::chrono::steady_clock::time_point::max()),
+	m_finished(0),
+	m_worker_index(worker_index),
+	m_reserved(reserved),
 	p_basepool(ref_pool)
 {
 
 	int result = 0;
+	pthread_attr_t thread_attr;
 
 	WorkerThread_log_info("WorkerThread[%p] \n", (void*)this);
 
-	// create new worker thread
-	if ( 0 != ( result = pthread_create(&id_worker_thread, NULL, pthread_func, this)) )
+	// create new thread condition (before thread creation -> used by worker_function)
+	if ( 0 != ( result = pthread_cond_init(&m_worker_cond, NULL)) )
+	{
+		WorkerThread_log_error("WorkerThread: create condition failure: %i\n", result);
+		throw std::runtime_error("cannot create condition");
+	}
+
+	if (worker_attr)
 	{
+		// create new worker thread with given attributes
+		if ( 0 != ( result = worker_attr->initPthreadAttr(&thread_attr, worker_index)) )
+		{
+			// attr not initialized on failure -> nothing to destroy
+			WorkerThread_log_error("WorkerThread: init thread attributes failure: %i \n", result);
+			throw std::runtime_error("init worker thread attributes failure");
+		}
+
+		result = pthread_create(&id_worker_thread, &thread_attr, pthread_func, this);
+		pthread_attr_destroy(&thread_attr);
+	}
+	else
+	{
+		// create new worker thread
+		result = pthread_create(&id_worker_thread, NULL, pthread_func, this);
+	}
+
+	if ( 0 != result )
+	{
+		id_worker_thread = 0;
 		ThreadPool_log_error("create worker thread failure: %i \n", result);
 		throw std::runtime_error("create worker thread failure");
 	}
 
-	// create new thread condition
-	if ( 0 != ( result = pthread_cond_init(&m_worker_cond, NULL)) )
+	if (worker_attr && !worker_attr->getThreadName(worker_index).empty())
 	{
-		WorkerThread_log_error("WorkerThread: create condition failure: %i\n", result);
-		throw std::runtime_error("cannot create condition");
+		pthread_setname_np(id_worker_thread, worker_attr->getThreadName(worker_index).c_str());
 	}
 }
 
 WorkerThread::~WorkerThread()
 {
-	int wait_count=0;
 	WorkerThread_log_info("~WorkerThread[%p]\n", (void*)this);
 
 	resetBaseRef();
-
-	m_worker_running = false; //disable worker thread
-	pthread_cond_signal(&m_worker_cond);
+	stopWorker();
 
 	/**
 	 * wait for ending worker thread function
 	 * @todo how to kill blocked thread function?
 	 */
-	while (m_status != worker_finished
-			&& !(m_fast_shutdown
-					&& wait_count++ > 1000))
-	{
-		WorkerThread_log_trace("~wait for finish worker[%p]\n", this);
-		usleep(100);
-	}
-
-	if (m_status == worker_finished)
+	if (waitFinished(m_finish_deadline))
 	{
 		//at this point the worker thread should have ended -> join it
 		if (id_worker_thread > 0 )
@@ -95,7 +118,6 @@ WorkerThread::~WorkerThread()
 void WorkerThread::worker_function(void)
 {
 	FunctorInt *curFunctor = NULL;
-	pthread_mutex_t fakeMutex = PTHREAD_MUTEX_INITIALIZER;
 
 	while (m_worker_running)
 	{
@@ -113,14 +135,9 @@ void WorkerThread::worker_function(void)
 
 				if (p_base)
 				{ //parent object valid
-					std::lock_guard<std::mutex> lock(p_base->m_functor_lock); // lock before queue access
 					if (m_worker_running)
 					{
-						if (p_base->m_functor_queue.size() > 0)
-						{
-							curFunctor = p_base->m_functor_queue.front(); // get next functor from queue
-							p_base->m_functor_queue.pop_front(); // remove functor from queue
-						}
+						curFunctor = p_base->fetchFunctor(this); // get next functor from queue
 					}
 				}
 				else
@@ -129,8 +146,8 @@ void WorkerThread::worker_function(void)
 				}
 			}
 
-			//exit loop
-			if (!m_worker_running)
+			//exit loop (fetched functor is handled before)
+			if (!m_worker_running && curFunctor == NULL)
 			{
 				break;
 			}
@@ -140,43 +157,94 @@ void WorkerThread::worker_function(void)
 			{
 				//logger->debug("get next functor");
 				m_status = worker_running; //
-				WorkerThread_log_trace("curFunctor[%p]->functor_function();\n", curFunctor);
-				try
-				{
-					curFunctor->functor_function(); // call handling function
-				}
-				catch (...)
-				{
-					WorkerThread_log_error("Exception in functor_function();\n");
-				}
-				delete curFunctor;	//delete object
+				executeFunctor(curFunctor);
 			}
 			else
 			{
 				//nothing to do -> wait for work (reduce cpu load)
 				m_status = worker_idle;
-			    pthread_mutex_lock(&fakeMutex);
-				pthread_cond_wait(&m_worker_cond, &fakeMutex);
-				pthread_mutex_unlock(&fakeMutex);
+				pthread_mutex_lock(&m_worker_mutex);
+				while (!m_wakeup && m_worker_running)
+				{
+					pthread_cond_wait(&m_worker_cond, &m_worker_mutex);
+				}
+				m_wakeup = false;
+				pthread_mutex_unlock(&m_worker_mutex);
 			}
 		}
 	}
 
 	WorkerThread_log_debug("exit worker_function[%p]\n", (void*)this);
 	m_status = worker_finished;
+	m_finished.store(1, std::memory_order_release);
+	futex_wake(&m_finished);	// destructor joins thread before freeing object
 	return; //running mode changed -> exit thread
 }
 
+bool WorkerThread::waitFinished(std::chrono::steady_clock::time_point deadline)
+{
+	while (m_finished.load(std::memory_order_acquire) == 0)
+	{
+		int64_t timeout_us = -1;
+
+		if (deadline != std::chrono::steady_clock::time_point::max())
+		{
+			timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(
+					deadline - std::chrono::steady_clock::now()).count();
+			if (timeout_us <= 0)
+			{
+				return false;
+			}
+		}
+		WorkerThread_log_trace("~wait for finish worker[%p]\n", this);
+		futex_wait(&m_finished, 0, timeout_us);
+	}
+	return true;
+}
+
+void WorkerThread::executeFunctor(FunctorInt *functor)
+{
+	WorkerThread_log_trace("curFunctor[%p]->functor_execute();\n", functor);
+	try
+	{
+		functor->functor_execute(); // call handling function and delete object
+	}
+	catch (...)
+	{
+		WorkerThread_log_error("Exception in functor_function();\n");
+	}
+}
+
 bool WorkerThread::wakeupWorker( void )
 {
+	bool result = false;
+
 	if ( m_status == worker_idle )
 	{
+		pthread_mutex_lock(&m_worker_mutex);
+		m_wakeup = true;
 		if ( 0 == pthread_cond_signal(&m_worker_cond))
 		{
-			return true;
+			result = true;
 		}
+		pthread_mutex_unlock(&m_worker_mutex);
 	}
-	return false;
+	return result;
+}
+
+StopToken WorkerThread::getCurrentStopToken( void )
+{
+	ThreadPool *p_base = p_current_worker ? dynamic_cast<ThreadPool*>(p_current_worker->p_basepool) : NULL;
+
+	return p_base ? p_base->getStopToken() : StopToken();
+}
+
+void WorkerThread::stopWorker( void )
+{
+	pthread_mutex_lock(&m_worker_mutex);
+	m_worker_running = false; //disable worker thread
+	pthread_cond_signal(&m_worker_cond);
+	pthread_mutex_unlock(&m_worker_mutex);
 }
 
 void* WorkerThread::pthread_func(void * ptr)
@@ -188,6 +256,7 @@ void* WorkerThread::pthread_func(void * ptr)
 		return NULL;
 	}
 
+	p_current_worker = p_self;
 	p_self->worker_function();
 
 	return NULL;
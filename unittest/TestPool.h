@@ -9,9 +9,17 @@
 #define TESTPOOL_H_
 
 #include <ThreadPool.h>
+#include <TaskGroup.h>
+#include <TaskGraph.h>
+#include <Strand.h>
+#include <AsyncIo.h>
+#include <CompletionQueue.h>
 #include <memory>
+#include <atomic>
 #include "DummyFunctor.h"
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 #define TEST_FUNC_CONSTRUCT	5
 
@@ -26,6 +34,10 @@ public:
 
 	TestPool(uint8_t worker_count = 1, bool auto_start = true);
 	virtual ~TestPool();
+
+	using ThreadPool::clearQueue;
+	using ThreadPool::addWorker;
+	using ThreadPool::delWorker;
 };
 
 
@@ -85,6 +97,344 @@ private:
 };
 
 
+class Attr_Functor: public Functor {
+public:
+	Attr_Functor(std::shared_ptr<std::string> thread_name, std::shared_ptr<cpu_set_t> cpuset):
+		sp_thread_name(thread_name), sp_cpuset(cpuset){
+	};
+	virtual ~Attr_Functor(){};
+	virtual void functor_function(void) {
+		char name[16] = {0};
+
+		pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), sp_cpuset.get());
+		pthread_getname_np(pthread_self(), name, sizeof(name));
+		*sp_thread_name.get() = name;
+	}
+
+private:
+	std::shared_ptr<std::string> sp_thread_name;
+	std::shared_ptr<cpu_set_t> sp_cpuset;
+};
+
+class Nested_Group_Functor: public Functor {
+public:
+	Nested_Group_Functor(ThreadPool *pool, std::shared_ptr<uint32_t> result_flag):
+		p_pool(pool), sp_result_flag(result_flag){
+	};
+	virtual ~Nested_Group_Functor(){};
+	virtual void functor_function(void) {
+		TaskGroup group(p_pool);
+
+		group.delegateFunctor(new Dummy_Functor(10, true));
+		group.delegateFunctor(new Dummy_Functor(10, true));
+
+		*sp_result_flag.get() = group.waitAll(2000) ? 1 : 2;
+	}
+
+private:
+	ThreadPool *p_pool;
+	std::shared_ptr<uint32_t> sp_result_flag;
+};
+
+class Seq_Functor: public Functor {
+public:
+	Seq_Functor(std::shared_ptr<std::atomic<int> > counter, int *slot):
+		sp_counter(counter), p_slot(slot){
+	};
+	virtual ~Seq_Functor(){};
+	virtual void functor_function(void) {
+		usleep(1000);
+		*p_slot = (*sp_counter.get())++;
+	}
+
+private:
+	std::shared_ptr<std::atomic<int> > sp_counter;
+	int *p_slot;
+};
+
+/**
+ * append sequence number to log of strand, detect concurrent execution
+ */
+class Strand_Functor: public Functor {
+public:
+	Strand_Functor(Strand *strand, std::vector<int> *log, std::atomic<int> *active, std::atomic<int> *overlap, int seq):
+		p_strand(strand), p_log(log), p_active(active), p_overlap(overlap), m_seq(seq){
+	};
+	virtual ~Strand_Functor(){};
+	virtual void functor_function(void) {
+		if (p_active->fetch_add(1) != 0 || !p_strand->isCurrent()) {
+			p_overlap->fetch_add(1);
+		}
+		p_log->push_back(m_seq);
+		p_active->fetch_sub(1);
+	}
+
+private:
+	Strand *p_strand;
+	std::vector<int> *p_log;
+	std::atomic<int> *p_active;
+	std::atomic<int> *p_overlap;
+	int m_seq;
+};
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+/**
+ * store handling order, count reported misses
+ */
+class Deadline_Functor: public DeadlineFunctor {
+public:
+	Deadline_Functor(std::shared_ptr<std::atomic<int> > counter, int *slot, std::atomic<int> *missed):
+		sp_counter(counter), p_slot(slot), p_missed(missed){
+	};
+	virtual ~Deadline_Functor(){};
+	virtual void functor_function(void) {
+		*p_slot = (*sp_counter.get())++;
+	}
+	virtual void deadline_missed(void) {
+		(*p_missed)++;
+	}
+
+private:
+	std::shared_ptr<std::atomic<int> > sp_counter;
+	int *p_slot;
+	std::atomic<int> *p_missed;
+};
+#endif
+
+/**
+ * append id to log (single worker -> no lock)
+ */
+class Log_Functor: public Functor {
+public:
+	Log_Functor(std::vector<int> *log, int id):
+		p_log(log), m_id(id){
+	};
+	virtual ~Log_Functor(){};
+	virtual void functor_function(void) {
+		p_log->push_back(m_id);
+	}
+
+private:
+	std::vector<int> *p_log;
+	int m_id;
+};
+
+/**
+ * store index of executing worker
+ */
+class Index_Functor: public Functor {
+public:
+	Index_Functor(ThreadPool *pool, std::atomic<int> *index):
+		p_pool(pool), p_index(index){
+	};
+	virtual ~Index_Functor(){};
+	virtual void functor_function(void) {
+		*p_index = p_pool->getCurrentWorkerIndex();
+	}
+
+private:
+	ThreadPool *p_pool;
+	std::atomic<int> *p_index;
+};
+
+/**
+ * count calls (e.g. stop callback)
+ */
+class Count_Functor: public Functor {
+public:
+	Count_Functor(std::atomic<int> *count):
+		p_count(count){
+	};
+	virtual ~Count_Functor(){};
+	virtual void functor_function(void) {
+		(*p_count)++;
+	}
+
+private:
+	std::atomic<int> *p_count;
+};
+
+/**
+ * run until stop is requested (max. 5s), count stopped runs and stop callbacks
+ */
+class Stop_Functor: public StopFunctor {
+public:
+	Stop_Functor(std::atomic<int> *stopped, std::atomic<int> *callbacks):
+		p_stopped(stopped), p_callbacks(callbacks){
+	};
+	virtual ~Stop_Functor(){};
+	virtual void functor_function(void) {
+		StopCallback callback(getStopToken(), new Count_Functor(p_callbacks));
+
+		for (int i = 0; i < 50000 && !stopRequested(); i++) {
+			usleep(100);
+		}
+		if (stopRequested()) {
+			(*p_stopped)++;
+		}
+	}
+
+private:
+	std::atomic<int> *p_stopped;
+	std::atomic<int> *p_callbacks;
+};
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+/**
+ * run until deadline stops it (max. 5s)
+ */
+class Stop_Deadline_Functor: public DeadlineFunctor, public StopFunctorInt {
+public:
+	Stop_Deadline_Functor(std::atomic<int> *stopped, int polls = 50000):
+		p_stopped(stopped), m_polls(polls){
+	};
+	virtual ~Stop_Deadline_Functor(){};
+	virtual void functor_function(void) {
+		for (int i = 0; i < m_polls && !stopRequested(); i++) {
+			usleep(100);
+		}
+		if (stopRequested()) {
+			(*p_stopped)++;
+		}
+	}
+
+private:
+	std::atomic<int> *p_stopped;
+	int m_polls;
+};
+#endif
+
+/**
+ * functor waiting within managed blocking section until running flag is reset
+ */
+class Blocking_Functor: public Functor {
+public:
+	Blocking_Functor(ThreadPool *pool, std::shared_ptr<bool> running_flag):
+		p_pool(pool), sp_running_flag(running_flag){
+	};
+	virtual ~Blocking_Functor(){};
+	virtual void functor_function(void) {
+		BlockingScope blocking(p_pool);
+
+		while(*sp_running_flag.get()){
+			usleep(100);
+		}
+	}
+
+private:
+	ThreadPool *p_pool;
+	std::shared_ptr<bool> sp_running_flag;
+};
+
+/**
+ * short managed blocking section, count calls
+ */
+class Blocking_Count_Functor: public Functor {
+public:
+	Blocking_Count_Functor(ThreadPool *pool, std::atomic<int> *count, uint32_t block_us):
+		p_pool(pool), p_count(count), m_block_us(block_us){
+	};
+	virtual ~Blocking_Count_Functor(){};
+	virtual void functor_function(void) {
+		BlockingScope blocking(p_pool);
+
+		usleep(m_block_us);
+		(*p_count)++;
+	}
+
+private:
+	ThreadPool *p_pool;
+	std::atomic<int> *p_count;
+	uint32_t m_block_us;
+};
+
+#ifndef NO_REACTOR_TP_SUPPORT
+/**
+ * handler of ready file descriptor: count read bytes (until EAGAIN)
+ */
+class Read_IoFunctor: public IoFunctor {
+public:
+	Read_IoFunctor():
+		m_bytes(0), m_calls(0), m_parallel(0), m_overlap(false){
+	};
+	virtual ~Read_IoFunctor(){};
+	virtual void io_ready(uint32_t events) {
+		char buffer[256];
+		ssize_t len;
+
+		if (m_parallel.fetch_add(1) != 0) {
+			m_overlap = true;
+		}
+		m_calls++;
+		if (events & EPOLLIN) {
+			while ((len = read(getFd(), buffer, sizeof(buffer))) > 0) {
+				m_bytes += len;
+			}
+		}
+		m_parallel--;
+	}
+
+	std::atomic<size_t> m_bytes;
+	std::atomic<uint32_t> m_calls;
+	std::atomic<int32_t> m_parallel;
+	bool m_overlap;
+};
+#endif
+
+/**
+ * continuation of asynchronous I/O: sum results, count completions
+ */
+class Io_Result_Functor: public AsyncIoFunctor {
+public:
+	Io_Result_Functor(std::atomic<int64_t> *result_sum, std::atomic<int> *done):
+		p_result_sum(result_sum), p_done(done){
+	};
+	virtual ~Io_Result_Functor(){};
+	virtual void functor_function(void) {
+		*p_result_sum += getIoResult();
+		(*p_done)++;
+	}
+
+private:
+	std::atomic<int64_t> *p_result_sum;
+	std::atomic<int> *p_done;
+};
+
+#ifdef TP_COROUTINE_SUPPORT
+/**
+ * coroutine: move to pool, return square of value (computed by a WorkerThread)
+ */
+inline Task<int> coro_square(ThreadPool *pool, int value){
+	co_await pool->schedule();
+	co_return pool->isWorkerThread() ? value * value : -1;
+}
+
+/**
+ * coroutine: await nested tasks and a delayed resume
+ */
+inline Task<int> coro_sum_squares(ThreadPool *pool, int count){
+	int sum = 0;
+
+	co_await pool->schedule();
+	for (int i = 1; i <= count; i++) {
+		sum += co_await coro_square(pool, i);
+	}
+#ifndef NO_DELAYED_TP_SUPPORT
+	co_await pool->scheduleAfter(std::chrono::milliseconds(20));
+#endif
+	co_return pool->isWorkerThread() ? sum : -1;
+}
+
+#ifndef NO_DELAYED_TP_SUPPORT
+/**
+ * coroutine: wait for given delay within pool
+ */
+inline Task<int> coro_delayed(ThreadPool *pool, uint32_t delay_ms){
+	co_await pool->scheduleAfter(std::chrono::milliseconds(delay_ms));
+	co_return 1;
+}
+#endif
+#endif
 
 } /* namespace ThreadPool */
 } /* namespace icke2063 */
@@ -0,0 +1,416 @@
+/*
+ * pool_bench.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: icke
+ *
+ *  Benchmarks for ThreadPool based algorithms
+ *  usage: pool_bench <test letter> [max worker count]
+ */
+
+#include <memory>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ThreadPool.h"
+#include "ParallelFor.h"
+#include "ParallelReduce.h"
+using namespace icke2063::threadpool;
+
+#define TP_BENCH_ARRAY_SIZE	(1 << 22)
+#define TP_BENCH_REPEAT		5
+
+/**
+ * get best runtime of given function in microseconds
+ */
+template <typename Func>
+static double bench_us(Func func)
+{
+	double best = -1;
+
+	for (int i = 0; i < TP_BENCH_REPEAT; i++) {
+		std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+		func();
+		double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t_start).count();
+		if (best < 0 || us < best) {
+			best = us;
+		}
+	}
+	return best;
+}
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+/**
+ * busy functor: count completions after deadline
+ */
+class Bench_Deadline_Functor: public DeadlineFunctor {
+public:
+	Bench_Deadline_Functor(uint32_t work_us, std::atomic<int> *done, std::atomic<int> *late):
+		m_work_us(work_us), p_done(done), p_late(late) {}
+
+	virtual void functor_function(void) {
+		std::chrono::steady_clock::time_point t_end = std::chrono::steady_clock::now() + std::chrono::microseconds(m_work_us);
+		while (std::chrono::steady_clock::now() < t_end) {}
+
+		if (std::chrono::steady_clock::now() > getDeadline()) {
+			(*p_late)++;
+		}
+		(*p_done)++;
+	}
+
+	virtual void deadline_missed(void) { (*p_done)++; }
+
+private:
+	uint32_t m_work_us;
+	std::atomic<int> *p_done;
+	std::atomic<int> *p_late;
+};
+#endif
+
+/**
+ * empty functor (queue overhead only)
+ */
+class Bench_Empty_Functor: public Functor {
+public:
+	Bench_Empty_Functor(std::atomic<int> *done): p_done(done) {}
+	virtual void functor_function(void) { (*p_done)++; }
+
+private:
+	std::atomic<int> *p_done;
+};
+
+/**
+ * wait until running flag is reset (block workers while queue is filled)
+ */
+class Bench_Block_Functor: public Functor {
+public:
+	Bench_Block_Functor(std::atomic<bool> *running): p_running(running) {}
+	virtual void functor_function(void) {
+		while (*p_running) {
+			usleep(100);
+		}
+	}
+
+private:
+	std::atomic<bool> *p_running;
+};
+
+#if !defined(NO_PRIORITY_TP_SUPPORT) && !defined(NO_DEADLINE_TP_SUPPORT)
+///results of one scheduler run
+struct Bench_Sched_Stats {
+	std::chrono::steady_clock::time_point t_release;
+	std::atomic<int> done;
+	std::atomic<int> missed;
+	std::atomic<int> high_count;
+	std::atomic<int64_t> high_us;
+	std::atomic<int64_t> low_us;
+};
+
+/**
+ * busy functor: completion time since release of queue by priority class, count deadline misses
+ */
+class Bench_Sched_Functor: public DeadlineFunctor {
+public:
+	Bench_Sched_Functor(uint32_t work_us, Bench_Sched_Stats *stats):
+		m_work_us(work_us), p_stats(stats) {}
+
+	virtual void functor_function(void) {
+		std::chrono::steady_clock::time_point t_end = std::chrono::steady_clock::now() + std::chrono::microseconds(m_work_us);
+		while (std::chrono::steady_clock::now() < t_end) {}
+
+		std::chrono::steady_clock::time_point tnow = std::chrono::steady_clock::now();
+		int64_t used_us = std::chrono::duration_cast<std::chrono::microseconds>(tnow - p_stats->t_release).count();
+		if (getPriority() > 50) {
+			p_stats->high_us += used_us;
+			p_stats->high_count++;
+		} else {
+			p_stats->low_us += used_us;
+		}
+		if (tnow > getDeadline()) {
+			p_stats->missed++;
+		}
+		p_stats->done++;
+	}
+
+private:
+	uint32_t m_work_us;
+	Bench_Sched_Stats *p_stats;
+};
+#endif
+
+int main(int argc, char **argv){
+
+int max_worker = (argc >= 3) ? atoi(argv[2]) : 8;
+
+if(argc >= 2){
+		switch (argv[1][0]) {
+		case 'A':
+		{
+			/**
+			 * parallel_for vs. serial loop
+			 * - light workload: scale array (memory bound)
+			 * - heavy workload: transcendental functions (compute bound)
+			 */
+			printf("Bench A:\n");
+			printf("parallel_for vs. serial loop [%d elements]\n", TP_BENCH_ARRAY_SIZE);
+
+			std::vector<double> data(TP_BENCH_ARRAY_SIZE, 1.0);
+			double *p_data = &data[0];
+
+			double serial_light = bench_us([p_data]() {
+				for (size_t i = 0; i < TP_BENCH_ARRAY_SIZE; i++) {
+					p_data[i] = p_data[i] * 1.000001 + 0.5;
+				}
+			});
+			double serial_heavy = bench_us([p_data]() {
+				for (size_t i = 0; i < TP_BENCH_ARRAY_SIZE; i++) {
+					p_data[i] = sin(p_data[i]) * cos(p_data[i]) + sqrt(fabs(p_data[i]));
+				}
+			});
+
+			printf("workload\tworker\ttime[us]\tspeedup\n");
+			printf("light\t\tserial\t%.0f\t\t1.00\n", serial_light);
+			printf("heavy\t\tserial\t%.0f\t\t1.00\n", serial_heavy);
+
+			for (int worker = 1; worker <= max_worker; worker *= 2) {
+				std::unique_ptr<ThreadPool> pool(new ThreadPool(worker));
+
+				double light = bench_us([&pool, p_data]() {
+					parallel_for(pool.get(), 0, TP_BENCH_ARRAY_SIZE, 4096,
+							[p_data](size_t i) { p_data[i] = p_data[i] * 1.000001 + 0.5; }, sizeof(double));
+				});
+				double heavy = bench_us([&pool, p_data]() {
+					parallel_for(pool.get(), 0, TP_BENCH_ARRAY_SIZE, 1024,
+							[p_data](size_t i) { p_data[i] = sin(p_data[i]) * cos(p_data[i]) + sqrt(fabs(p_data[i])); },
+							sizeof(double));
+				});
+
+				printf("light\t\t%d\t%.0f\t\t%.2f\n", worker, light, serial_light / light);
+				printf("heavy\t\t%d\t%.0f\t\t%.2f\n", worker, heavy, serial_heavy / heavy);
+			}
+		}
+		break;
+
+		case 'B':
+		{
+			/**
+			 * parallel reduce / transform-reduce / scan scaling from 1 to max worker
+			 */
+			printf("Bench B:\n");
+			printf("parallel reduce and scan [%d elements]\n", TP_BENCH_ARRAY_SIZE);
+
+			std::vector<double> data(TP_BENCH_ARRAY_SIZE);
+			std::vector<double> result(TP_BENCH_ARRAY_SIZE);
+			volatile double sink = 0;
+
+			for (size_t i = 0; i < TP_BENCH_ARRAY_SIZE; i++) {
+				data[i] = (double)(i % 1000) * 0.001;
+			}
+
+			double serial_sum = bench_us([&]() { sink = std::accumulate(data.begin(), data.end(), 0.0); });
+			double serial_max = bench_us([&]() { sink = *std::max_element(data.begin(), data.end()); });
+			double serial_scan = bench_us([&]() { std::partial_sum(data.begin(), data.end(), result.begin()); });
+
+			printf("algorithm\tworker\ttime[us]\tspeedup\n");
+			printf("sum\t\tserial\t%.0f\t\t1.00\n", serial_sum);
+			printf("max\t\tserial\t%.0f\t\t1.00\n", serial_max);
+			printf("scan\t\tserial\t%.0f\t\t1.00\n", serial_scan);
+
+			for (int worker = 1; worker <= max_worker; worker++) {
+				std::unique_ptr<ThreadPool> pool(new ThreadPool(worker));
+
+				double sum = bench_us([&]() {
+					sink = parallel_reduce(pool.get(), data.begin(), data.end(), 0.0,
+							[](double a, double b) { return a + b; });
+				});
+				double max = bench_us([&]() {
+					sink = parallel_reduce(pool.get(), data.begin(), data.end(), 0.0,
+							[](double a, double b) { return a > b ? a : b; });
+				});
+				double scan = bench_us([&]() {
+					parallel_inclusive_scan(pool.get(), data.begin(), data.end(), result.begin(),
+							[](double a, double b) { return a + b; });
+				});
+
+				printf("sum\t\t%d\t%.0f\t\t%.2f\n", worker, sum, serial_sum / sum);
+				printf("max\t\t%d\t%.0f\t\t%.2f\n", worker, max, serial_max / max);
+				printf("scan\t\t%d\t%.0f\t\t%.2f\n", worker, scan, serial_scan / scan);
+			}
+			(void)sink;
+		}
+		break;
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+		case 'C':
+		{
+			/**
+			 * deadline miss rate under load/overload: FIFO vs. EDF vs. EDF with dropping expired functors
+			 * - functors arrive with 90% and 125% of pool capacity, relative deadline random within [2, 20] * work time
+			 * - missed: completed after deadline or dropped
+			 */
+			const int count = 1000;
+			const uint32_t work_us = 200;
+			int worker = (max_worker < 8) ? max_worker : 2;
+			const double loads[2] = {0.9, 1.25};
+
+			printf("Bench C:\n");
+			printf("deadline miss rate [%d functors, %u us, %d worker]\n", count, work_us, worker);
+			printf("load\tmode\t\tlate\tdropped\tmissed[%%]\n");
+
+			std::vector<int64_t> slack_us(count);
+			std::mt19937 rng(2063);
+			std::uniform_int_distribution<int64_t> dist(2 * work_us, 20 * work_us);
+			for (int i = 0; i < count; i++) {
+				slack_us[i] = dist(rng);
+			}
+
+			const char *mode_name[3] = {"FIFO", "EDF", "EDF+drop"};
+			for (int load = 0; load < 2; load++)
+			for (int mode = 0; mode < 3; mode++) {
+				double interarrival_us = (double)work_us / worker / loads[load];
+				std::unique_ptr<ThreadPool> pool(new ThreadPool(worker));
+				std::atomic<int> done(0);
+				std::atomic<int> late(0);
+
+				pool->setDeadlinePolicy(mode == 2 ? TP_DEADLINE_Drop : TP_DEADLINE_Run);
+
+				std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+				int next = 0;
+				while (next < count) {
+					// submit all functors arrived until now (1ms batches)
+					std::chrono::steady_clock::time_point tnow = std::chrono::steady_clock::now();
+					while (next < count && t_start + std::chrono::microseconds((int64_t)(next * interarrival_us)) <= tnow) {
+						std::chrono::steady_clock::time_point arrival =
+								t_start + std::chrono::microseconds((int64_t)(next * interarrival_us));
+						Bench_Deadline_Functor *functor = new Bench_Deadline_Functor(work_us, &done, &late);
+						functor->setDeadline(arrival + std::chrono::microseconds(slack_us[next]));
+#ifndef NO_PRIORITY_TP_SUPPORT
+						FunctorInt *result = (mode == 0) ? pool->delegateFunctor(functor, TPI_ADD_FiFo) : pool->delegateDeadlineFunctor(functor);
+#else
+						FunctorInt *result = (mode == 0) ? pool->delegateFunctor(functor) : pool->delegateDeadlineFunctor(functor);
+#endif
+						if (result != NULL) {
+							delete functor;
+							done++;
+						}
+						next++;
+					}
+					usleep(1000);
+				}
+				while (done < count) {
+					usleep(1000);
+				}
+
+				int dropped = pool->getDeadlineDropCount();
+				printf("%.0f%%\t%s\t%s%d\t%d\t%.1f\n", loads[load] * 100, mode_name[mode], mode == 2 ? "" : "\t", (int)late, dropped,
+						100.0 * (late + dropped) / count);
+			}
+		}
+		break;
+#endif
+
+		case 'D':
+		{
+			/**
+			 * queue disciplines (createScheduler) against the same workloads
+			 * - throughput: empty functors through a bounded queue (delegateFunctorWait)
+			 * - burst: blocked worker, queue filled with mixed priority/deadline functors, then released
+			 */
+			const int count = 100000;
+
+			printf("Bench D:\n");
+			printf("queue disciplines [throughput: %d functors, %d worker]\n", count, max_worker);
+			printf("scheduler\ttime[us]\tfunctors/s\n");
+
+			for (size_t sched = 0; getSchedulerName(sched) != NULL; sched++) {
+				const char *name = getSchedulerName(sched);
+				std::unique_ptr<ThreadPool> pool(new ThreadPool(max_worker, true, NULL, createScheduler(name)));
+				std::atomic<int> done(0);
+
+				std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+				for (int i = 0; i < count; i++) {
+					FunctorInt *functor = new Bench_Empty_Functor(&done);
+					if (pool->delegateFunctorWait(functor) != NULL) {
+						delete functor;
+						done++;
+					}
+				}
+				while (done < count) {
+					usleep(100);
+				}
+				double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t_start).count();
+				printf("%s\t\t%.0f\t\t%.0f\n", name, us, count / us * 1e6);
+			}
+
+#if !defined(NO_PRIORITY_TP_SUPPORT) && !defined(NO_DEADLINE_TP_SUPPORT)
+			const int burst = 800;
+			const uint32_t work_us = 50;
+
+			printf("queue disciplines [burst: %d functors, %u us, 1 worker, 20%% high priority]\n", burst, work_us);
+			printf("scheduler\thigh[us]\tlow[us]\tmissed[%%]\n");
+
+			std::vector<uint8_t> priority(burst);
+			std::vector<int64_t> deadline_us(burst);
+			std::mt19937 rng(2063);
+			std::uniform_int_distribution<int> prio_dist(0, 4);
+			std::uniform_int_distribution<int64_t> deadline_dist(burst * work_us / 2, burst * work_us * 2);
+			for (int i = 0; i < burst; i++) {
+				priority[i] = (prio_dist(rng) == 0) ? 90 : 10;
+				deadline_us[i] = deadline_dist(rng);
+			}
+
+			for (size_t sched = 0; getSchedulerName(sched) != NULL; sched++) {
+				const char *name = getSchedulerName(sched);
+				std::unique_ptr<ThreadPool> pool(new ThreadPool(1, true, NULL, createScheduler(name)));
+				std::atomic<bool> running(true);
+				Bench_Sched_Stats stats;
+
+				stats.done = 0;
+				stats.missed = 0;
+				stats.high_count = 0;
+				stats.high_us = 0;
+				stats.low_us = 0;
+
+				pool->delegateFunctor(new Bench_Block_Functor(&running));
+				usleep(10000);
+
+				std::chrono::steady_clock::time_point t_base = std::chrono::steady_clock::now();
+				for (int i = 0; i < burst; i++) {
+					Bench_Sched_Functor *functor = new Bench_Sched_Functor(work_us, &stats);
+					functor->setPriority(priority[i]);
+					functor->setDeadline(t_base + std::chrono::microseconds(deadline_us[i]));
+					if (pool->delegateFunctor(functor) != NULL) {
+						delete functor;
+						stats.done++;
+					}
+				}
+				stats.t_release = std::chrono::steady_clock::now();
+				running = false;
+				while (stats.done < burst) {
+					usleep(1000);
+				}
+
+				int high_count = stats.high_count;
+				printf("%s\t\t%.0f\t\t%.0f\t%.1f\n", name,
+						high_count ? (double)stats.high_us / high_count : 0.0,
+						(burst > high_count) ? (double)stats.low_us / (burst - high_count) : 0.0,
+						100.0 * stats.missed / burst);
+			}
+#endif
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+}
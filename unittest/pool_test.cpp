@@ -7,9 +7,22 @@
 
 //#include <auto_ptr.h>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <chrono>
 #include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <functional>
 
 #include "ThreadPool.h"
+#include "BasicThreadPool.h"
+#include "ParallelFor.h"
+#include "ParallelReduce.h"
 #include "TestPool.h"
 //#include <icke2063_TP_config.h>
 using namespace icke2063::threadpool;
@@ -396,6 +409,2257 @@ if(argc >= 2){
 		break;
 #endif
 
+		case 'F':
+		{
+			/**
+			 * Test WorkerAttr -> name, affinity and stack size of worker threads
+			 */
+
+			printf("Test F:\n");
+			printf("Worker attribute test\n");
+
+			int counter;
+			std::shared_ptr<std::string> name(new std::string);
+			std::shared_ptr<cpu_set_t> cpuset(new cpu_set_t);
+			WorkerAttr attr;
+
+			CPU_ZERO(cpuset.get());
+			attr.setName("tp_test");
+			attr.setStackSize(256 * 1024);
+			attr.addAffinityCpu(0);
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1, true, &attr));
+
+			testpool->delegateFunctor(new icke2063::threadpool::Attr_Functor(name, cpuset));
+
+			counter = 0;
+			while (name->empty() && (counter++ < 1000)) {
+				usleep(1000);
+			}
+
+			printf("name[%s]:\t", name->c_str());
+			if (*name.get() != "tp_test-0") {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("affinity:\t");
+			if (CPU_COUNT(cpuset.get()) != 1 || !CPU_ISSET(0, cpuset.get())) {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+			printf("Test[F]: passed\n");
+		}
+		break;
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+		case 'G':
+		{
+			/**
+			 * Test reserved lane -> high priority functor runs while all normal workers are blocked
+			 */
+
+			printf("Test G:\n");
+			printf("Reserved lane test\n");
+
+			int counter;
+			std::shared_ptr<bool> running(new bool);
+			std::shared_ptr<uint32_t> flag(new uint32_t);
+			(*running.get()) = true;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+
+			printf("lane:\t\t");
+			if (!testpool->setReservedLane(1, 50) || testpool->getReservedWorkerCount() != 1
+					|| testpool->getWorkerCount() != 2) {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			//block normal worker and queue low priority functor
+			testpool->delegateFunctor(new icke2063::threadpool::Endless_Functor(running));
+			testpool->delegateFunctor(new icke2063::threadpool::Endless_Functor(running));
+
+			Functor *urgent = new icke2063::threadpool::Test_Functor(flag, 0, true);
+			urgent->setPriority(100);
+			testpool->delegateFunctor(urgent);
+
+			counter = 0;
+			while ((*flag.get()) != icke2063::threadpool::Test_Functor::stop && (counter++ < 1000)) {
+				usleep(1000);
+			}
+
+			printf("urgent:\t\t");
+			if (counter >= 1000) {
+				printf("failed\n");
+				(*running.get()) = false;
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("low prio queued:\t");
+			if (testpool->getQueueCount() != 1) {
+				printf("failed\n");
+				(*running.get()) = false;
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			// aged low priority functor stays before new urgent one
+			printf("aged head:\t");
+			testpool->setPrioAging(1);
+			usleep(150 * 1000);
+			std::shared_ptr<uint32_t> aged_flag(new uint32_t);
+			(*aged_flag.get()) = icke2063::threadpool::Test_Functor::init;
+			urgent = new icke2063::threadpool::Test_Functor(aged_flag, 0, true);
+			urgent->setPriority(100);
+			testpool->delegateFunctor(urgent);
+
+			counter = 0;
+			while ((*aged_flag.get()) != icke2063::threadpool::Test_Functor::stop && (counter++ < 1000)) {
+				usleep(1000);
+			}
+			if (counter >= 1000 || testpool->getQueueCount() != 1) {
+				printf("failed\n");
+				(*running.get()) = false;
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			(*running.get()) = false;
+			printf("Test[G]: passed\n");
+		}
+		break;
+#endif
+
+		case 'H':
+		{
+			/**
+			 * Test TaskGroup -> wait for all/any functor without polling
+			 */
+
+			printf("Test H:\n");
+			printf("TaskGroup test\n");
+
+			int counter;
+			std::shared_ptr<uint32_t> flag(new uint32_t);
+			(*flag.get()) = 0;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(4));
+
+			{
+				TaskGroup group(testpool.get());
+
+				for (int i = 0; i < 8; i++) {
+					group.delegateFunctor(new icke2063::threadpool::Dummy_Functor(50, true));
+				}
+
+				printf("waitAll[timeout]:\t");
+				if (group.waitAll(10)) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("waitAny:\t");
+				if (!group.waitAny(1000)) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("waitAll:\t");
+				if (!group.waitAll(1000) || group.getPendingCount() != 0 || group.getCompletedCount() != 7) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+			}
+
+			//waiting worker handles queued functors of nested group
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new icke2063::threadpool::Nested_Group_Functor(testpool.get(), flag));
+
+			counter = 0;
+			while ((*flag.get()) == 0 && (counter++ < 3000)) {
+				usleep(1000);
+			}
+
+			printf("nested:\t");
+			if ((*flag.get()) != 1) {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+			printf("Test[H]: passed\n");
+		}
+		break;
+
+		case 'I':
+		{
+			/**
+			 * Test TaskGraph -> diamond graph A -> (B,C) -> D, run twice
+			 */
+
+			printf("Test I:\n");
+			printf("TaskGraph test\n");
+
+			std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+			int slot[4];
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(4));
+
+			{
+				TaskGraph graph(testpool.get());
+				TaskGraph::node_id a = graph.addNode(new icke2063::threadpool::Seq_Functor(counter, &slot[0]));
+				TaskGraph::node_id b = graph.addNode(new icke2063::threadpool::Seq_Functor(counter, &slot[1]));
+				TaskGraph::node_id c = graph.addNode(new icke2063::threadpool::Seq_Functor(counter, &slot[2]));
+				TaskGraph::node_id d = graph.addNode(new icke2063::threadpool::Seq_Functor(counter, &slot[3]));
+
+				printf("edges:\t\t");
+				if (!graph.addEdge(a, b) || !graph.addEdge(a, c) || !graph.addEdge(b, d) || !graph.addEdge(c, d)
+						|| graph.addEdge(d, a)) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("cycle check:\t");
+				{
+					// chain of 40 diamonds -> 2^40 paths from first to last node
+					TaskGraph lattice(testpool.get());
+					TaskGraph::node_id first = lattice.addNode(new Dummy_Functor(0, true));
+					TaskGraph::node_id last = first;
+					for (int i = 0; i < 40; i++) {
+						TaskGraph::node_id left = lattice.addNode(new Dummy_Functor(0, true));
+						TaskGraph::node_id right = lattice.addNode(new Dummy_Functor(0, true));
+						TaskGraph::node_id join = lattice.addNode(new Dummy_Functor(0, true));
+						lattice.addEdge(last, left);
+						lattice.addEdge(last, right);
+						lattice.addEdge(left, join);
+						lattice.addEdge(right, join);
+						last = join;
+					}
+					if (lattice.addEdge(last, first)) {
+						printf("failed\n");
+						exit(1);
+					}
+				}
+				printf("passed\n");
+
+				for (int run = 0; run < 2; run++) {
+					(*counter.get()) = 0;
+
+					printf("run[%d]:\t\t", run);
+					if (!graph.submit() || !graph.wait(2000) || (*counter.get()) != 4
+							|| slot[0] != 0 || slot[3] != 3) {
+						printf("failed\n");
+						exit(1);
+					} else {
+						printf("passed\n");
+					}
+				}
+			}
+			printf("Test[I]: passed\n");
+		}
+		break;
+
+		case 'J':
+		{
+			/**
+			 * Test parallel_for -> each index handled exactly once
+			 */
+
+			printf("Test J:\n");
+			printf("parallel_for test\n");
+
+			const size_t count = 100000;
+			std::vector<int> data(count, 0);
+
+			for (int worker = 1; worker <= 8; worker *= 2) {
+				testpool.reset(new icke2063::threadpool::ThreadPool(worker));
+
+				std::fill(data.begin(), data.end(), 0);
+				parallel_for(testpool.get(), 0, count, 100, [&data](size_t i) { data[i] += 1; }, sizeof(int));
+
+				printf("worker[%d]:\t", worker);
+				if (std::count(data.begin(), data.end(), 1) != (long)count) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+			}
+
+			//empty range
+			parallel_for(testpool.get(), 10, 10, 100, [&data](size_t i) { data[i] += 1; });
+			printf("Test[J]: passed\n");
+		}
+		break;
+
+		case 'K':
+		{
+			/**
+			 * Test parallel_reduce, parallel_transform_reduce and parallel scans
+			 */
+
+			printf("Test K:\n");
+			printf("parallel reduce/scan test\n");
+
+			const size_t count = 100003;
+			std::vector<long> data(count);
+			std::vector<long> result(count);
+			std::vector<long> expected(count);
+
+			for (size_t i = 0; i < count; i++) {
+				data[i] = (long)((i * 7919) % 1000) - 500;
+			}
+
+			for (int worker = 1; worker <= 8; worker *= 2) {
+				testpool.reset(new icke2063::threadpool::ThreadPool(worker));
+
+				printf("reduce[%d]:\t", worker);
+				if (parallel_reduce(testpool.get(), data.begin(), data.end(), 10L, [](long a, long b) { return a + b; })
+						!= std::accumulate(data.begin(), data.end(), 10L)) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("min[%d]:\t", worker);
+				if (parallel_reduce(testpool.get(), data.begin(), data.end(), 0L,
+						[](long a, long b) { return a < b ? a : b; }) != -500) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("transform[%d]:\t", worker);
+				long squares = 0;
+				for (size_t i = 0; i < count; i++) {
+					squares += data[i] * data[i];
+				}
+				if (parallel_transform_reduce(testpool.get(), data.begin(), data.end(), 0L,
+						[](long a, long b) { return a + b; }, [](long a) { return a * a; }) != squares) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("inclusive[%d]:\t", worker);
+				std::partial_sum(data.begin(), data.end(), expected.begin());
+				parallel_inclusive_scan(testpool.get(), data.begin(), data.end(), result.begin(),
+						[](long a, long b) { return a + b; });
+				if (result != expected) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+
+				printf("exclusive[%d]:\t", worker);
+				expected[0] = 3;
+				std::partial_sum(data.begin(), data.end() - 1, expected.begin() + 1);
+				std::for_each(expected.begin() + 1, expected.end(), [](long &value) { value += 3; });
+				parallel_exclusive_scan(testpool.get(), data.begin(), data.end(), result.begin(), 3L,
+						[](long a, long b) { return a + b; });
+				if (result != expected) {
+					printf("failed\n");
+					exit(1);
+				} else {
+					printf("passed\n");
+				}
+			}
+			printf("Test[K]: passed\n");
+		}
+		break;
+
+#ifdef TP_COROUTINE_SUPPORT
+		case 'L':
+		{
+			/**
+			 * Test C++20 coroutine integration (schedule, scheduleAfter, Task<T>)
+			 */
+
+			printf("Test L:\n");
+			printf("coroutine test\n");
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+
+			printf("schedule:\t");
+			if (coro_square(testpool.get(), 7).get() != 49) {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("nested:\t\t");
+			std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+			int sum = coro_sum_squares(testpool.get(), 10).get();
+			long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::steady_clock::now() - t_start).count();
+#ifndef NO_DELAYED_TP_SUPPORT
+			if (sum != 385 || elapsed_ms < 20) {
+#else
+			if (sum != 385) {
+#endif
+				printf("failed[%d/%ldms]\n", sum, elapsed_ms);
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("many:\t\t");
+			std::vector<Task<int> > tasks;
+			for (int i = 0; i < 1000; i++) {
+				tasks.push_back(coro_square(testpool.get(), i % 100));
+			}
+			for (int i = 0; i < 1000; i++) {
+				if (tasks[i].get() != (i % 100) * (i % 100)) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#ifndef NO_DELAYED_TP_SUPPORT
+			printf("dropped delay:\t");
+			{
+				int result = 0;
+				std::thread caller([&]() {
+					try {
+						result = coro_delayed(testpool.get(), 10000).get();
+					} catch (std::runtime_error &) {
+						result = -2;	// resumed as cancelled
+					}
+				});
+				for (int i = 0; i < 1000 && testpool->getDQueueCount() == 0; i++) {
+					usleep(1000);
+				}
+				testpool->shutdown(TP_SHUTDOWN_Abort);
+				caller.join();
+				if (result != -2) {
+					printf("failed[%d]\n", result);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+#endif
+			printf("Test[L]: passed\n");
+		}
+		break;
+#endif
+
+		case 'M':
+		{
+			/**
+			 * Test Strand: FIFO order and no concurrent execution per strand
+			 */
+
+			printf("Test M:\n");
+			printf("strand test\n");
+
+			const int strand_count = 1000;
+			const int functor_count = 200;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(4));
+
+			std::vector<std::vector<int> > logs(strand_count);
+			std::vector<std::atomic<int> > active(strand_count);
+			std::atomic<int> overlap(0);
+			{
+				std::vector<std::unique_ptr<Strand> > strands;
+				for (int i = 0; i < strand_count; i++) {
+					strands.push_back(std::unique_ptr<Strand>(new Strand(testpool.get())));
+					active[i] = 0;
+				}
+
+				for (int seq = 0; seq < functor_count; seq++) {
+					for (int i = 0; i < strand_count; i++) {
+						if (strands[i]->post(new Strand_Functor(strands[i].get(), &logs[i], &active[i], &overlap, seq)) != NULL) {
+							printf("post failed\n");
+							exit(1);
+						}
+					}
+				}
+				// destructors wait for completion
+			}
+
+			printf("overlap:\t");
+			if (overlap != 0) {
+				printf("failed[%d]\n", (int)overlap);
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("order:\t\t");
+			for (int i = 0; i < strand_count; i++) {
+				for (int seq = 0; seq < functor_count; seq++) {
+					if ((int)logs[i].size() != functor_count || logs[i][seq] != seq) {
+						printf("failed[strand %d]\n", i);
+						exit(1);
+					}
+				}
+			}
+			printf("passed\n");
+			printf("Test[M]: passed\n");
+		}
+		break;
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+		case 'N':
+		{
+			/**
+			 * Test earliest-deadline-first queue and expired functor policies
+			 */
+
+			printf("Test N:\n");
+			printf("deadline test\n");
+
+			const int count = 10;
+			std::shared_ptr<bool> running(new bool(true));
+			std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+			std::atomic<int> missed(0);
+			int slots[count];
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			// add in reverse deadline order
+			for (int i = 0; i < count; i++) {
+				slots[i] = -1;
+				Deadline_Functor *functor = new Deadline_Functor(counter, &slots[i], &missed);
+				functor->setDeadlineIn(std::chrono::seconds(10 + count - i));
+				if (testpool->delegateDeadlineFunctor(functor) != NULL) {
+					printf("delegate failed\n");
+					exit(1);
+				}
+			}
+			*running = false;
+			while (testpool->getDeadlineQueueCount() > 0 || *counter < count) {
+				usleep(1000);
+			}
+
+			printf("order:\t\t");
+			for (int i = 0; i < count; i++) {
+				if (slots[i] != count - 1 - i) {
+					printf("failed[%d:%d]\n", i, slots[i]);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			// expired deadlines
+			int policies[2] = {TP_DEADLINE_Report, TP_DEADLINE_Drop};
+			for (int p = 0; p < 2; p++) {
+				*running = true;
+				*counter = 0;
+				missed = 0;
+				testpool->setDeadlinePolicy(policies[p]);
+				testpool->delegateFunctor(new Endless_Functor(running));
+				usleep(10000);
+
+				for (int i = 0; i < count; i++) {
+					slots[i] = -1;
+					Deadline_Functor *functor = new Deadline_Functor(counter, &slots[i], &missed);
+					functor->setDeadlineIn(std::chrono::milliseconds((i % 2) ? 5 : 10000));
+					testpool->delegateDeadlineFunctor(functor);
+				}
+				usleep(20000);	// odd functors expire
+				*running = false;
+
+				int expected = (policies[p] == TP_DEADLINE_Report) ? count : count / 2;
+				int retry = 1000;
+				while ((*counter < expected || missed < count / 2) && retry-- > 0) {
+					usleep(1000);
+				}
+				usleep(10000);
+
+				printf("%s:\t\t", (policies[p] == TP_DEADLINE_Report) ? "report" : "drop");
+				if (*counter != expected || missed != count / 2
+						|| (policies[p] == TP_DEADLINE_Drop && (slots[1] != -1 || (int)testpool->getDeadlineDropCount() != count / 2))) {
+					printf("failed[%d/%d]\n", (int)*counter, (int)missed);
+					exit(1);
+				}
+				printf("passed\n");
+			}
+			printf("Test[N]: passed\n");
+		}
+		break;
+#endif
+
+#ifndef NO_TENANT_TP_SUPPORT
+		case 'O':
+		{
+			/**
+			 * Test weighted fair share between tenants (deficit round robin, queue limits)
+			 */
+
+			printf("Test O:\n");
+			printf("tenant test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+			std::vector<int> log;
+			TenantStats stats;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->setTenant(1, 1, 100);
+			testpool->setTenant(2, 3, 100);
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			// tenant 1 floods, tenant 2 and normal queue add few functors
+			int rejected = 0;
+			for (int i = 0; i < 500; i++) {
+				FunctorInt *functor = new Log_Functor(&log, 1);
+				if (testpool->delegateTenantFunctor(functor, 1) != NULL) {
+					delete functor;
+					rejected++;
+				}
+			}
+			for (int i = 0; i < 30; i++) {
+				testpool->delegateTenantFunctor(new Log_Functor(&log, 2), 2);
+			}
+			for (int i = 0; i < 10; i++) {
+				testpool->delegateFunctor(new Log_Functor(&log, 0));
+			}
+
+			printf("limit:\t\t");
+			if (rejected != 400 || !testpool->getTenantStats(1, stats) || stats.rejected != 400 || stats.queued != 100) {
+				printf("failed[%d]\n", rejected);
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			*running = false;
+			while (log.size() < 140) {
+				usleep(1000);
+			}
+			usleep(10000);
+
+			// weights 1:3:1 -> within first 50 functors: tenant 2 completed, no starvation of normal queue
+			int share[3] = {0, 0, 0};
+			for (int i = 0; i < 50; i++) {
+				share[log[i]]++;
+			}
+
+			printf("share:\t\t");
+			if (share[2] != 30 || share[0] < 8 || share[1] < 8 || share[1] > 12) {
+				printf("failed[%d/%d/%d]\n", share[0], share[1], share[2]);
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("stats:\t\t");
+			if (!testpool->getTenantStats(2, stats) || stats.submitted != 30 || stats.dispatched != 30 || stats.queued != 0
+					|| !testpool->getTenantStats(1, stats) || stats.dispatched != 100 || testpool->getTenantStats(3, stats)) {
+				printf("failed\n");
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+			printf("Test[O]: passed\n");
+		}
+		break;
+#endif
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+		case 'P':
+		{
+			/**
+			 * Test priority aging: long waiting low priority functor passes newer higher priority ones
+			 */
+
+			printf("Test P:\n");
+			printf("priority aging test\n");
+
+			for (int aging = 0; aging < 2; aging++) {
+				std::shared_ptr<bool> running(new bool(true));
+				std::vector<int> log;
+
+				testpool.reset(new icke2063::threadpool::ThreadPool(1));
+				testpool->setPrioAging(aging ? 10 : 0);
+				testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+				usleep(10000);
+
+				Functor *functor = new Log_Functor(&log, 0);
+				functor->setPriority(0);
+				testpool->delegateFunctor(functor);
+				usleep(150000);		// >= 15 aging steps
+
+				functor = new Log_Functor(&log, 1);
+				functor->setPriority(5);
+				testpool->delegateFunctor(functor);
+				functor = new Log_Functor(&log, 2);
+				functor->setPriority(3);
+				testpool->delegateFunctor(functor);
+				functor = new Log_Functor(&log, 3);
+				functor->setPriority(90);
+				testpool->delegateFunctor(functor);
+
+				*running = false;
+				while (log.size() < 4) {
+					usleep(1000);
+				}
+
+				// aging: 90 > aged 0 (15+) > 5 > 3, no aging: 90 > 5 > 3 > 0
+				int expected_aging[4] = {3, 0, 1, 2};
+				int expected_plain[4] = {3, 1, 2, 0};
+				int *expected = aging ? expected_aging : expected_plain;
+
+				printf("aging[%d]:\t", aging);
+				for (int i = 0; i < 4; i++) {
+					if (log[i] != expected[i]) {
+						printf("failed[%d:%d]\n", i, log[i]);
+						exit(1);
+					}
+				}
+				printf("passed\n");
+			}
+			printf("Test[P]: passed\n");
+		}
+		break;
+#endif
+
+		case 'Q':
+		{
+			/**
+			 * Test blocking and timed delegate on full functor queue
+			 */
+
+			printf("Test Q:\n");
+			printf("backpressure test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			// fill queue
+			int added = 0;
+			while (true) {
+				FunctorInt *functor = new Dummy_Functor(0, true);
+				if (testpool->delegateFunctor(functor) != NULL) {
+					delete functor;
+					break;
+				}
+				added++;
+			}
+
+			printf("timeout:\t");
+			std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+			FunctorInt *functor = new Dummy_Functor(0, true);
+			if (added != FUNCTOR_MAX || testpool->delegateFunctorWait(functor, 50) != functor
+					|| std::chrono::steady_clock::now() - t_start < std::chrono::milliseconds(50)) {
+				printf("failed[%d]\n", added);
+				exit(1);
+			} else {
+				printf("passed\n");
+			}
+
+			printf("blocking:\t");
+			std::thread release_thread([running]() {
+				usleep(50000);
+				*running = false;		// worker drains queue
+			});
+			t_start = std::chrono::steady_clock::now();
+			for (int i = 0; i < 100; i++) {
+				if (testpool->delegateFunctorWait(new Dummy_Functor(0, true)) != NULL) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			release_thread.join();
+			if (std::chrono::steady_clock::now() - t_start < std::chrono::milliseconds(40)) {
+				printf("failed[no wait]\n");
+				exit(1);
+			}
+			delete functor;
+			printf("passed\n");
+			printf("Test[Q]: passed\n");
+		}
+		break;
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+		case 'R':
+		{
+			/**
+			 * Test overload policies on full functor queue
+			 */
+
+			printf("Test R:\n");
+			printf("overload policy test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+			std::vector<int> log;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			// fill queue: first functor id 1 (oldest, lowest priority -> handled last), others id 0
+			for (int i = 0; i < FUNCTOR_MAX; i++) {
+				Functor *functor = new Log_Functor(&log, (i == 0) ? 1 : 0);
+				functor->setPriority((i == 0) ? 10 : 20);
+				if (testpool->delegateFunctor(functor) != NULL) {
+					printf("fill failed\n");
+					exit(1);
+				}
+			}
+
+			printf("reject:\t\t");
+			FunctorInt *functor = new Log_Functor(&log, 2);
+			if (testpool->delegateFunctor(functor) != functor || testpool->getOverloadCount(TP_OVERLOAD_Reject) != 1) {
+				printf("failed\n");
+				exit(1);
+			}
+			delete functor;
+			printf("passed\n");
+
+			printf("caller runs:\t");
+			testpool->setOverloadPolicy(TP_OVERLOAD_CallerRuns);
+			if (testpool->delegateFunctor(new Log_Functor(&log, 3)) != NULL || log.size() != 1 || log[0] != 3
+					|| testpool->getOverloadCount(TP_OVERLOAD_CallerRuns) != 1) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("drop oldest:\t");
+			testpool->setOverloadPolicy(TP_OVERLOAD_DropOldest);
+			Functor *prio_functor = new Log_Functor(&log, 4);
+			prio_functor->setPriority(10);
+			if (testpool->delegateFunctor(prio_functor) != NULL || testpool->getQueueCount() != FUNCTOR_MAX
+					|| testpool->getOverloadDropCount() != 1) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("evict lowest:\t");
+			testpool->setOverloadPolicy(TP_OVERLOAD_EvictLowest);
+			prio_functor = new Log_Functor(&log, 5);
+			prio_functor->setPriority(5);		// lower than queued -> rejected
+			if (testpool->delegateFunctor(prio_functor) != prio_functor) {
+				printf("failed[low]\n");
+				exit(1);
+			}
+			delete prio_functor;
+			prio_functor = new Log_Functor(&log, 6);
+			prio_functor->setPriority(50);		// higher than queued -> evicts last one
+			if (testpool->delegateFunctor(prio_functor) != NULL || testpool->getOverloadDropCount() != 2
+					|| testpool->getOverloadCount(TP_OVERLOAD_EvictLowest) != 2) {
+				printf("failed[high]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			*running = false;
+			while (testpool->getQueueCount() > 0) {
+				usleep(1000);
+			}
+			usleep(10000);
+
+			// 3 by caller, 6 first (priority 50), dropped oldest (1) and evicted tail (4) never handled
+			printf("handled:\t");
+			if (log.size() != FUNCTOR_MAX + 1 || log[1] != 6 || std::count(log.begin(), log.end(), 1) != 0
+					|| std::count(log.begin(), log.end(), 4) != 0) {
+				printf("failed[%d]\n", (int)log.size());
+				exit(1);
+			}
+			printf("passed\n");
+			printf("Test[R]: passed\n");
+		}
+		break;
+#endif
+
+		case 'S':
+		{
+			/**
+			 * Test queue position by ticket
+			 */
+
+			printf("Test S:\n");
+			printf("queue ticket test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+			std::vector<int> log;
+			QueueTicket tickets[6];
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			printf("fifo position:\t");
+			for (int i = 0; i < 5; i++) {
+				if (testpool->delegateFunctorTicket(new Log_Functor(&log, i), tickets[i]) != NULL
+						|| !tickets[i].valid || testpool->getQueuePos(tickets[i]) != i || testpool->isStarted(tickets[i])) {
+					printf("failed[%d]\n", i);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+			printf("prio position:\t");
+			Functor *prio_functor = new Log_Functor(&log, 5);
+			prio_functor->setPriority(50);
+			if (testpool->delegateFunctorTicket(prio_functor, tickets[5]) != NULL
+					|| testpool->getQueuePos(tickets[5]) != 0 || testpool->getQueuePos(tickets[4]) != 5) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+#endif
+
+			*running = false;
+			while (testpool->getQueueCount() > 0) {
+				usleep(1000);
+			}
+			usleep(10000);
+
+			printf("started:\t");
+			for (int i = 0; i < 5; i++) {
+				if (!testpool->isStarted(tickets[i]) || testpool->getQueuePos(tickets[i]) != -1) {
+					printf("failed[%d]\n", i);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#ifndef NO_PRIORITY_TP_SUPPORT
+			printf("evicted:\t");
+			{
+				std::vector<QueueTicket> fill(FUNCTOR_MAX);
+				QueueTicket urgent_ticket;
+				QueueTicket next_ticket;
+				std::shared_ptr<bool> blocking(new bool(true));
+
+				*running = true;
+				testpool.reset(new icke2063::threadpool::ThreadPool(1));
+				testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+				usleep(10000);
+				for (int i = 0; i < FUNCTOR_MAX; i++) {
+					Functor *functor = new Log_Functor(&log, 0);
+					functor->setPriority(10);
+					testpool->delegateFunctorTicket(functor, fill[i]);
+				}
+
+				// evicts tail of level 10 -> no dequeue of its head
+				testpool->setOverloadPolicy(TP_OVERLOAD_EvictLowest);
+				prio_functor = new Log_Functor(&log, 0);
+				prio_functor->setPriority(50);
+				if (testpool->delegateFunctorTicket(prio_functor, urgent_ticket) != NULL || testpool->isStarted(fill[0])
+						|| testpool->getQueuePos(fill[0]) != 1 || testpool->getQueuePos(urgent_ticket) != 0) {
+					printf("failed[evict]\n");
+					exit(1);
+				}
+
+				*running = false;
+				while (testpool->getQueueCount() > 0) {
+					usleep(1000);
+				}
+				usleep(10000);
+				for (int i = 0; i < FUNCTOR_MAX - 1; i++) {
+					if (!testpool->isStarted(fill[i])) {
+						printf("failed[%d]\n", i);
+						exit(1);
+					}
+				}
+
+				// dequeue cursor passes evicted sequence number
+				testpool->delegateFunctor(new Endless_Functor(blocking));
+				usleep(10000);
+				Functor *functor = new Log_Functor(&log, 0);
+				functor->setPriority(10);
+				if (testpool->delegateFunctorTicket(functor, next_ticket) != NULL || testpool->isStarted(next_ticket)
+						|| testpool->getQueuePos(next_ticket) != 0) {
+					printf("failed[next]\n");
+					exit(1);
+				}
+				*blocking = false;
+				while (testpool->getQueueCount() > 0) {
+					usleep(1000);
+				}
+				usleep(10000);
+				if (!testpool->isStarted(next_ticket) || !testpool->isStarted(fill[FUNCTOR_MAX - 1])) {
+					printf("failed[skip]\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+#endif
+			printf("Test[S]: passed\n");
+		}
+		break;
+
+#ifndef NO_RATE_TP_SUPPORT
+		case 'T':
+		{
+			/**
+			 * Test token bucket rate limit (parked functors)
+			 */
+
+			printf("Test T:\n");
+			printf("rate limit test\n");
+
+			std::vector<int> log;
+			RateStats stats;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->setRateLimit(1, 20, 2);	// 20 per second, burst 2
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			printf("budget:\t\t");
+			for (int i = 0; i < 6; i++) {
+				if (testpool->delegateRateFunctor(new Log_Functor(&log, i), 1) != NULL) {
+					printf("failed[%d]\n", i);
+					exit(1);
+				}
+			}
+			if (!testpool->getRateStats(1, stats) || stats.passed != 2 || stats.parked != 4 || stats.rejected != 0) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("rate:\t\t");
+			while (log.size() < 6) {
+				usleep(1000);
+			}
+			// 4 parked functors with one token per 50ms
+			std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+			if (elapsed < std::chrono::milliseconds(190)) {
+				printf("failed[%d ms]\n", (int)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+				exit(1);
+			}
+			for (int i = 0; i < 6; i++) {
+				if (log[i] != i) {
+					printf("failed[order]\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("invalid class:\t");
+			FunctorInt *functor = new Log_Functor(&log, 0);
+			if (testpool->delegateRateFunctor(functor, TP_RATE_CLASS_MAX) != functor || testpool->setRateLimit(TP_RATE_CLASS_MAX, 1)) {
+				printf("failed\n");
+				exit(1);
+			}
+			delete functor;
+			printf("passed\n");
+			printf("Test[T]: passed\n");
+		}
+		break;
+#endif
+
+		case 'U':
+		{
+			/**
+			 * Test managed blocking (compensating worker)
+			 */
+
+			printf("Test U:\n");
+			printf("managed blocking test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+			std::vector<int> log;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			testpool->delegateFunctor(new Blocking_Functor(testpool.get(), running));
+			usleep(10000);
+
+			printf("compensate:\t");
+			if (testpool->getBlockedCount() != 1 || testpool->getWorkerCount() != 2) {
+				printf("failed[%d]\n", (int)testpool->getWorkerCount());
+				exit(1);
+			}
+			testpool->delegateFunctor(new Log_Functor(&log, 1));
+			for (int i = 0; i < 100 && log.size() < 1; i++) {
+				usleep(1000);
+			}
+			if (log.size() != 1) {
+				printf("failed[blocked]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("no worker:\t");
+			if (testpool->beginBlocking()) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("retire:\t\t");
+			*running = false;
+			for (int i = 0; i < 100 && testpool->getWorkerCount() > 1; i++) {
+				usleep(1000);
+			}
+			if (testpool->getBlockedCount() != 0 || testpool->getWorkerCount() != 1) {
+				printf("failed[%d]\n", (int)testpool->getWorkerCount());
+				exit(1);
+			}
+			printf("passed\n");
+
+#ifndef NO_DYNAMIC_TP_SUPPORT
+			printf("dynamic:\t");
+			{
+				std::atomic<int> executed(0);
+				std::vector<std::thread> producers;
+
+				// worker creation/removal by blocking sections and dynamic handling concurrently
+				testpool.reset(new icke2063::threadpool::ThreadPool(2));
+				testpool->setDynEnable(true);
+				testpool->setHighWatermark(32);
+				testpool->setLowWatermark(2);
+				testpool->setTPMainLoopIdleTime(1000);
+				for (int p = 0; p < 4; p++) {
+					producers.push_back(std::thread([&]() {
+						for (int i = 0; i < 500; i++) {
+							FunctorInt *functor = (i % 2) ? (FunctorInt*)new Count_Functor(&executed)
+									: new Blocking_Count_Functor(testpool.get(), &executed, 200);
+							if (testpool->delegateFunctorWait(functor, 1000) != NULL) {
+								delete functor;
+								executed++;
+							}
+						}
+					}));
+				}
+				for (size_t p = 0; p < producers.size(); p++) {
+					producers[p].join();
+				}
+				for (int i = 0; i < 10000 && executed < 2000; i++) {
+					usleep(1000);
+				}
+				if (executed != 2000) {
+					printf("failed[%d]\n", executed.load());
+					exit(1);
+				}
+				testpool.reset();
+			}
+			printf("passed\n");
+#endif
+			printf("Test[U]: passed\n");
+		}
+		break;
+
+#ifndef NO_REACTOR_TP_SUPPORT
+		case 'V':
+		{
+			/**
+			 * Test epoll reactor with pipe and socketpair
+			 */
+
+			printf("Test V:\n");
+			printf("reactor test\n");
+
+			int pipe_fds[2];
+			int socket_fds[2];
+			Read_IoFunctor pipe_handler;
+			Read_IoFunctor socket_handler;
+			Log_Functor no_io_handler(NULL, 0);
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+			testpool->setTPMainLoopIdleTime(100000);	// reactor has to wake up on events
+
+			if (pipe2(pipe_fds, O_NONBLOCK) != 0
+					|| socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, socket_fds) != 0) {
+				printf("fd creation failed\n");
+				exit(1);
+			}
+
+			printf("register:\t");
+			if (!testpool->registerFd(pipe_fds[0], EPOLLIN, &pipe_handler)
+					|| !testpool->registerFd(socket_fds[0], EPOLLIN, &socket_handler)
+					|| testpool->registerFd(pipe_fds[0], EPOLLIN, &pipe_handler)
+					|| testpool->registerFd(pipe_fds[1], EPOLLOUT, &no_io_handler)) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("pipe:\t\t");
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int i = 0; i < 100; i++) {
+				if (write(pipe_fds[1], "0123456789", 10) != 10) {
+					printf("failed[write]\n");
+					exit(1);
+				}
+			}
+			for (int i = 0; i < 1000 && pipe_handler.m_bytes < 1000; i++) {
+				usleep(100);
+			}
+			if (pipe_handler.m_bytes != 1000 || pipe_handler.m_overlap
+					|| std::chrono::steady_clock::now() - start > std::chrono::milliseconds(50)) {
+				printf("failed[%d]\n", (int)pipe_handler.m_bytes);
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("socketpair:\t");
+			if (write(socket_fds[1], "abc", 3) != 3) {
+				printf("failed[write]\n");
+				exit(1);
+			}
+			for (int i = 0; i < 1000 && socket_handler.m_bytes < 3; i++) {
+				usleep(100);
+			}
+			if (socket_handler.m_bytes != 3) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("unregister:\t");
+			if (!testpool->unregisterFd(pipe_fds[0]) || testpool->unregisterFd(pipe_fds[0])
+					|| !testpool->unregisterFd(socket_fds[0])) {
+				printf("failed\n");
+				exit(1);
+			}
+			uint32_t calls = pipe_handler.m_calls;
+			if (write(pipe_fds[1], "x", 1) != 1) {
+				printf("failed[write]\n");
+				exit(1);
+			}
+			usleep(20000);
+			while (pipe_handler.isPending() || socket_handler.isPending()) {
+				usleep(1000);
+			}
+			if (pipe_handler.m_calls != calls) {
+				printf("failed[calls]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			testpool.reset();
+			close(pipe_fds[0]);
+			close(pipe_fds[1]);
+			close(socket_fds[0]);
+			close(socket_fds[1]);
+			printf("Test[V]: passed\n");
+		}
+		break;
+#endif
+
+		case 'W':
+		{
+			/**
+			 * Test asynchronous file I/O (io_uring and emulation)
+			 */
+
+			printf("Test W:\n");
+			printf("async io test\n");
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+
+			for (int mode = 0; mode < 2; mode++) {
+				char path[] = "/tmp/pool_test_XXXXXX";
+				int fd = mkstemp(path);
+				std::atomic<int64_t> result_sum(0);
+				std::atomic<int> done(0);
+				const char *text = "0123456789abcdef";
+				char buffer[4][4];
+
+				if (fd < 0) {
+					printf("mkstemp failed\n");
+					exit(1);
+				}
+				unlink(path);
+
+				{
+					AsyncIo async_io(testpool.get(), 16, mode == 1);
+					printf("%s:\t", async_io.isEmulated() ? "emulation" : "io_uring");
+
+					if (async_io.write(fd, text, 16, 0, new Io_Result_Functor(&result_sum, &done)) != NULL) {
+						printf("failed[write]\n");
+						exit(1);
+					}
+					while (done < 1) {
+						usleep(100);
+					}
+
+					// batch of reads with one submission
+					for (int i = 0; i < 4; i++) {
+						if (async_io.read(fd, buffer[i], 4, 4 * i, new Io_Result_Functor(&result_sum, &done), false) != NULL) {
+							printf("failed[read]\n");
+							exit(1);
+						}
+					}
+					async_io.flush();
+					while (done < 5) {
+						usleep(100);
+					}
+
+					// error result
+					async_io.read(-1, buffer[0], 4, 0, new Io_Result_Functor(&result_sum, &done));
+				}	// waits for operations in flight
+				close(fd);
+
+				while (done < 6) {
+					usleep(100);
+				}
+				if (result_sum != 32 - EBADF || memcmp(buffer[1], text + 4, 4) != 0 || memcmp(buffer[3], text + 12, 4) != 0) {
+					printf("failed[%lld]\n", (long long)result_sum);
+					exit(1);
+				}
+				printf("passed\n");
+			}
+			printf("Test[W]: passed\n");
+		}
+		break;
+
+		case 'X':
+		{
+			/**
+			 * Test completion queue with eventfd (external event loop)
+			 */
+
+			printf("Test X:\n");
+			printf("completion queue test\n");
+
+			std::vector<int> log;
+			std::vector<int> work_slots(10, -1);
+			std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+			CompletionQueue queue;
+			struct pollfd poll_fd;
+
+			poll_fd.fd = queue.getFd();
+			poll_fd.events = POLLIN;
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+
+			printf("idle:\t\t");
+			if (!queue.isValid() || poll(&poll_fd, 1, 0) != 0) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("completion:\t");
+			for (int i = 0; i < 10; i++) {
+				testpool->delegateFunctor(queue.wrap(new Seq_Functor(counter, &work_slots[i]), new Log_Functor(&log, i)));
+			}
+			// external event loop: completions are handled within this thread
+			while (log.size() < 10) {
+				if (poll(&poll_fd, 1, 1000) != 1) {
+					printf("failed[poll]\n");
+					exit(1);
+				}
+				queue.drain();
+			}
+			for (int i = 0; i < 10; i++) {
+				if (work_slots[i] < 0) {
+					printf("failed[work]\n");
+					exit(1);
+				}
+			}
+			if (poll(&poll_fd, 1, 0) != 0 || queue.getPendingCount() != 0) {
+				printf("failed[signal]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("drain limit:\t");
+			queue.post(new Log_Functor(&log, 10));
+			queue.post(new Log_Functor(&log, 11));
+			if (queue.drain(1) != 1 || poll(&poll_fd, 1, 0) != 1 || queue.drain() != 1 || log.size() != 12) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+#ifndef NO_DELAYED_TP_SUPPORT
+			printf("delayed due:\t");
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::chrono::steady_clock::time_point deadline = start + std::chrono::milliseconds(20);
+			testpool->delegateDelayedFunctor(std::shared_ptr<DelayedFunctorInt>(
+					new DelayedFunctor(queue.wrap(NULL, new Log_Functor(&log, 12)), deadline)));
+			if (poll(&poll_fd, 1, 1000) != 1 || std::chrono::steady_clock::now() < deadline
+					|| queue.drain() != 1 || log.back() != 12) {
+				printf("failed\n");
+				exit(1);
+			}
+			printf("passed\n");
+#endif
+			testpool.reset();
+			printf("Test[X]: passed\n");
+		}
+		break;
+
+		case 'Y':
+		{
+			/**
+			 * Test worker mailboxes (submit by worker index/key)
+			 */
+
+			printf("Test Y:\n");
+			printf("worker mailbox test\n");
+
+			std::atomic<int> index[6];
+			std::shared_ptr<bool> running_flag(new bool(true));
+			FunctorInt *unknown = new Dummy_Functor(0, true);
+
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+			testpool->setMailboxLimit(4, 0);
+
+			int key_worker = testpool->getKeyWorker(42);
+			int other_worker = -1;
+
+			printf("key mapping:\t");
+			if (key_worker < 0 || testpool->getKeyWorker(42) != key_worker) {
+				printf("failed\n");
+				exit(1);
+			}
+			for (uint64_t key = 0; key < 64 && other_worker < 0; key++) {
+				if (testpool->getKeyWorker(key) != key_worker) {
+					other_worker = testpool->getKeyWorker(key);
+				}
+			}
+			if (other_worker < 0 || testpool->getCurrentWorkerIndex() != -1) {
+				printf("failed[spread]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("affinity:\t");
+			for (int i = 0; i < 6; i++) {
+				index[i] = -1;
+			}
+			testpool->delegateWorkerFunctor(new Index_Functor(testpool.get(), &index[0]), key_worker);
+			testpool->delegateWorkerFunctor(new Index_Functor(testpool.get(), &index[1]), other_worker);
+			testpool->delegateKeyFunctor(new Index_Functor(testpool.get(), &index[2]), 42);
+			usleep(50 * 1000);
+			if (index[0] != key_worker || index[1] != other_worker || index[2] != key_worker) {
+				printf("failed\n");
+				exit(1);
+			}
+			if (testpool->delegateWorkerFunctor(unknown, 999) != unknown) {
+				printf("failed[unknown]\n");
+				exit(1);
+			}
+			unknown->functor_release();
+			printf("passed\n");
+
+			printf("fallback:\t");
+			testpool->delegateWorkerFunctor(new Endless_Functor(running_flag), key_worker);
+			usleep(20 * 1000);
+			for (int i = 0; i < 5; i++) {
+				index[i] = -1;
+				testpool->delegateWorkerFunctor(new Index_Functor(testpool.get(), &index[i]), key_worker);
+			}
+			usleep(50 * 1000);
+			// mailbox full -> last functor handled by other worker
+			if (testpool->getMailboxFallbackCount() != 1 || testpool->getMailboxCount(key_worker) != 4
+					|| index[0] != -1 || index[4] != other_worker) {
+				printf("failed\n");
+				exit(1);
+			}
+			*running_flag = false;
+			usleep(50 * 1000);
+			if (index[0] != key_worker || index[3] != key_worker) {
+				printf("failed[order]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("stealing:\t");
+			testpool->setMailboxLimit(16, 2);
+			*running_flag = true;
+			testpool->delegateWorkerFunctor(new Endless_Functor(running_flag), key_worker);
+			usleep(20 * 1000);
+			for (int i = 0; i < 4; i++) {
+				index[i] = -1;
+				testpool->delegateWorkerFunctor(new Index_Functor(testpool.get(), &index[i]), key_worker);
+			}
+			usleep(50 * 1000);
+			// blocked worker keeps steal_min - 1 functors
+			if (testpool->getMailboxStealCount() != 3 || testpool->getMailboxCount(key_worker) != 1
+					|| index[3] != other_worker || index[0] != -1) {
+				printf("failed\n");
+				exit(1);
+			}
+			*running_flag = false;
+			usleep(50 * 1000);
+			if (index[0] != key_worker) {
+				printf("failed[own]\n");
+				exit(1);
+			}
+			printf("passed\n");
+
+			printf("remapping:\t");
+			{
+				TestPool keypool(4);
+				int mapping[256];
+				int highest = -1;
+#ifndef NO_DYNAMIC_TP_SUPPORT
+				keypool.setDynEnable(false);
+#endif
+				usleep(20 * 1000);
+				for (uint64_t key = 0; key < 256; key++) {
+					mapping[key] = keypool.getKeyWorker(key);
+					highest = mapping[key] > highest ? mapping[key] : highest;
+				}
+				// only keys of removed (highest) worker move
+				if (!keypool.delWorker()) {
+					printf("failed[del]\n");
+					exit(1);
+				}
+				for (uint64_t key = 0; key < 256; key++) {
+					int worker = keypool.getKeyWorker(key);
+					if (worker == highest || (mapping[key] != highest && worker != mapping[key])) {
+						printf("failed[del %i]\n", (int)key);
+						exit(1);
+					}
+				}
+				// only keys of new worker move
+				keypool.addWorker();
+				for (uint64_t key = 0; key < 256; key++) {
+					int worker = keypool.getKeyWorker(key);
+					if (worker != mapping[key]) {
+						printf("failed[add %i]\n", (int)key);
+						exit(1);
+					}
+				}
+			}
+			printf("passed\n");
+
+			testpool.reset();
+			printf("Test[Y]: passed\n");
+		}
+		break;
+
+		case 'Z':
+		{
+			/**
+			 * Test shutdown modes (drain, drain with deadline, abort)
+			 */
+
+			printf("Test Z:\n");
+			printf("shutdown test\n");
+
+			std::vector<int> slots(200, -1);
+			std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+			FunctorInt *refused = new Dummy_Functor(0, true);
+			size_t released;
+
+			printf("drain:\t\t");
+			testpool.reset(new icke2063::threadpool::ThreadPool(4));
+			for (int i = 0; i < 40; i++) {
+				testpool->delegateFunctor(new Seq_Functor(counter, &slots[i]));
+			}
+			released = testpool->shutdown(TP_SHUTDOWN_Drain);
+			if (released != 0 || *counter != 40 || !testpool->isShutdown() || testpool->getWorkerCount() != 0) {
+				printf("failed[%u/%i]\n", (unsigned int)released, counter->load());
+				exit(1);
+			}
+			if (testpool->delegateFunctor(refused) != refused || testpool->shutdown(TP_SHUTDOWN_Abort) != 0) {
+				printf("failed[refuse]\n");
+				exit(1);
+			}
+			refused->functor_release();
+			testpool.reset();
+			printf("passed\n");
+
+			printf("drain deadline:\t");
+			*counter = 0;
+			testpool.reset(new icke2063::threadpool::ThreadPool(1));
+			for (int i = 0; i < 200; i++) {
+				testpool->delegateFunctor(new Seq_Functor(counter, &slots[i]));
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			released = testpool->shutdown(TP_SHUTDOWN_DrainDeadline, 20);
+			std::chrono::steady_clock::duration used = std::chrono::steady_clock::now() - start;
+			if (released == 0 || released + *counter != 200 || used > std::chrono::milliseconds(150)) {
+				printf("failed[%u/%i]\n", (unsigned int)released, counter->load());
+				exit(1);
+			}
+			testpool.reset();
+			printf("passed\n");
+
+			printf("abort:\t\t");
+			*counter = 0;
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+			for (int i = 0; i < 50; i++) {
+				testpool->delegateFunctor(new Seq_Functor(counter, &slots[i]));
+			}
+#ifndef NO_DELAYED_TP_SUPPORT
+			// not due -> released
+			std::chrono::steady_clock::time_point due = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+			testpool->delegateDelayedFunctor(std::shared_ptr<DelayedFunctorInt>(
+					new DelayedFunctor(new Seq_Functor(counter, &slots[50]), due)));
+			released = testpool->shutdown(TP_SHUTDOWN_Abort) - 1;
+#else
+			released = testpool->shutdown(TP_SHUTDOWN_Abort);
+#endif
+			if (released == 0 || released + *counter != 50) {
+				printf("failed[%u/%i]\n", (unsigned int)released, counter->load());
+				exit(1);
+			}
+			testpool.reset();
+			printf("passed\n");
+
+			printf("parallel join:\t");
+			testpool.reset(new icke2063::threadpool::ThreadPool(32));
+			std::shared_ptr<bool> running_flag(new bool(true));
+			for (int i = 0; i < 8; i++) {
+				testpool->delegateFunctor(new Endless_Functor(running_flag));
+			}
+			usleep(20 * 1000);
+			*running_flag = false;
+			start = std::chrono::steady_clock::now();
+			released = testpool->shutdown(TP_SHUTDOWN_Drain);
+			used = std::chrono::steady_clock::now() - start;
+			if (released != 0 || used > std::chrono::milliseconds(100)) {
+				printf("failed[%lld ms]\n", (long long)std::chrono::duration_cast<std::chrono::milliseconds>(used).count());
+				exit(1);
+			}
+			testpool.reset();
+			printf("passed\n");
+
+			printf("Test[Z]: passed\n");
+		}
+		break;
+
+		case 'a':
+		{
+			/**
+			 * Test cooperative cancellation (stop token of pool, group and deadline)
+			 */
+
+			printf("Test a:\n");
+			printf("stop token test\n");
+
+			std::atomic<int> stopped(0);
+			std::atomic<int> callbacks(0);
+			std::atomic<int> executed(0);
+
+			printf("token:\t\t");
+			{
+				StopSource source;
+				StopSource linked(source.getToken());
+				StopToken token = linked.getToken();
+				StopCallback callback(token, new Count_Functor(&callbacks));
+
+				if (token.stopRequested() || !token.stopPossible() || StopToken().stopPossible()) {
+					printf("failed[init]\n");
+					exit(1);
+				}
+				if (!source.requestStop() || source.requestStop() || !token.stopRequested() || callbacks != 1) {
+					printf("failed[request]\n");
+					exit(1);
+				}
+				// registered after stop -> called immediately
+				StopCallback late(token, new Count_Functor(&callbacks));
+				if (callbacks != 2) {
+					printf("failed[late]\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("shutdown:\t");
+			stopped = 0;
+			callbacks = 0;
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+			testpool->delegateFunctor(new Stop_Functor(&stopped, &callbacks));
+			testpool->delegateFunctor(new Stop_Functor(&stopped, &callbacks));
+			usleep(20 * 1000);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			testpool->shutdown(TP_SHUTDOWN_Drain);
+			if (stopped != 2 || callbacks != 2
+					|| std::chrono::steady_clock::now() - start > std::chrono::milliseconds(500)) {
+				printf("failed[%i/%i]\n", stopped.load(), callbacks.load());
+				exit(1);
+			}
+			testpool.reset();
+			printf("passed\n");
+
+			printf("group cancel:\t");
+			stopped = 0;
+			callbacks = 0;
+			testpool.reset(new icke2063::threadpool::ThreadPool(2));
+			{
+				TaskGroup group(testpool.get());
+				FunctorInt *refused = new Count_Functor(&executed);
+
+				group.delegateFunctor(new Stop_Functor(&stopped, &callbacks));
+				group.delegateFunctor(new Stop_Functor(&stopped, &callbacks));
+				usleep(20 * 1000);
+				for (int i = 0; i < 5; i++) {
+					group.delegateFunctor(new Count_Functor(&executed));
+				}
+				group.cancel();
+				// queued functors are completed without handling
+				if (!group.waitAll(1000) || stopped != 2 || callbacks != 2 || executed != 0) {
+					printf("failed[%i/%i/%i]\n", stopped.load(), callbacks.load(), executed.load());
+					exit(1);
+				}
+				if (group.delegateFunctor(refused) != refused || testpool->getStopToken().stopRequested()) {
+					printf("failed[refuse]\n");
+					exit(1);
+				}
+				refused->functor_release();
+			}
+			printf("passed\n");
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+			printf("deadline:\t");
+			stopped = 0;
+			{
+				Stop_Deadline_Functor *deadline_functor = new Stop_Deadline_Functor(&stopped);
+
+				start = std::chrono::steady_clock::now();
+				deadline_functor->setDeadlineIn(std::chrono::milliseconds(30));
+				testpool->delegateDeadlineFunctor(deadline_functor);
+				for (int i = 0; i < 1000 && stopped == 0; i++) {
+					usleep(1000);
+				}
+				std::chrono::steady_clock::duration used = std::chrono::steady_clock::now() - start;
+				if (stopped != 1 || used < std::chrono::milliseconds(30) || used > std::chrono::milliseconds(500)) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("finished stops:\t");
+			stopped = 0;
+			for (int i = 0; i < 1000; i++) {
+				// far deadline, finished at once -> stop entry pruned before deadline
+				Stop_Deadline_Functor *deadline_functor = new Stop_Deadline_Functor(&stopped, 0);
+				deadline_functor->setDeadlineIn(std::chrono::hours(1));
+				while (testpool->delegateDeadlineFunctor(deadline_functor) != NULL) {
+					usleep(1000);
+				}
+				while (i % 32 == 31 && testpool->getDeadlineQueueCount() > 0) {
+					usleep(1000);
+				}
+			}
+			if (stopped != 0 || testpool->getDeadlineStopCount() > 2 * DEADLINE_STOPS_PRUNE_MIN) {
+				printf("failed[%d]\n", (int)testpool->getDeadlineStopCount());
+				exit(1);
+			}
+			printf("passed\n");
+#endif
+			testpool.reset();
+			printf("Test[a]: passed\n");
+		}
+		break;
+
+		case 'b':
+		{
+			/**
+			 * Test policy based BasicThreadPool (different configurations within one binary)
+			 */
+
+			printf("Test b:\n");
+			printf("BasicThreadPool test\n");
+
+			std::vector<int> slots(20, -1);
+			std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+			std::shared_ptr<bool> running_flag(new bool(true));
+			std::vector<int> log;
+
+			printf("fifo:\t\t");
+			{
+				BasicThreadPool<> pool(2);
+				for (int i = 0; i < 20; i++) {
+					if (!pool.submit(new Seq_Functor(counter, &slots[i]))) {
+						printf("failed[submit]\n");
+						exit(1);
+					}
+				}
+				pool.shutdown();
+				if (*counter != 20 || pool.getWorkerCount() != 0) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("priority:\t");
+			{
+				BasicThreadPool<PrioQueue<FunctorInt*, 3> > pool(1);
+				FunctorInt *refused = new Log_Functor(&log, 0);
+
+				pool.submit(new Endless_Functor(running_flag));
+				usleep(20 * 1000);
+				pool.submit(new Log_Functor(&log, 1), 1);
+				pool.submit(new Log_Functor(&log, 5), 5);
+				pool.submit(new Log_Functor(&log, 3), 3);
+				if (pool.submit(refused, 9)) {
+					printf("failed[full]\n");
+					exit(1);
+				}
+				refused->functor_release();
+				*running_flag = false;
+				pool.shutdown();
+				if (log.size() != 3 || log[0] != 5 || log[1] != 3 || log[2] != 1) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("timer:\t\t");
+			log.clear();
+			{
+				BasicThreadPool<FifoQueue<FunctorInt*>, SpinWake<>, FixedScaling, HeapTimer<FunctorInt*> > pool(1);
+
+				pool.submitAfter(new Log_Functor(&log, 2), std::chrono::milliseconds(40));
+				pool.submitAfter(new Log_Functor(&log, 1), std::chrono::milliseconds(20));
+				pool.submitAfter(new Log_Functor(&log, 3), std::chrono::seconds(10));
+				usleep(5 * 1000);
+				if (!log.empty() || pool.getTimerCount() != 3) {
+					printf("failed[early]\n");
+					exit(1);
+				}
+				usleep(100 * 1000);
+				// not due -> released by shutdown
+				pool.shutdown();
+				if (log.size() != 2 || log[0] != 1 || log[1] != 2 || pool.getTimerCount() != 0) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("scaling:\t");
+			{
+				std::atomic<int> done(0);
+				BasicThreadPool<FifoQueue<std::function<void(void)> >, CondVarWake, DynamicScaling<1, 4, 20> > pool(1);
+
+				for (int i = 0; i < 4; i++) {
+					pool.submit([&done](){ usleep(30 * 1000); done++; });
+				}
+				if (pool.getWorkerCount() < 2) {
+					printf("failed[grow]\n");
+					exit(1);
+				}
+				for (int i = 0; i < 100 && (done < 4 || pool.getWorkerCount() > 1); i++) {
+					usleep(10 * 1000);
+				}
+				if (done != 4 || pool.getWorkerCount() != 1) {
+					printf("failed[retire %u]\n", (unsigned int)pool.getWorkerCount());
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("Test[b]: passed\n");
+		}
+		break;
+
+		case 'c':
+		{
+			/**
+			 * Test exchangeable queue discipline (same functors, order depends on scheduler)
+			 */
+
+			printf("Test c:\n");
+			printf("scheduler test\n");
+
+			printf("create:\t\t");
+			{
+				std::unique_ptr<SchedulerInt> scheduler(createScheduler("unknown"));
+				if (scheduler.get() != NULL || getSchedulerName(0) == NULL) {
+					printf("failed\n");
+					exit(1);
+				}
+				scheduler.reset(createScheduler());
+				if (scheduler.get() == NULL || strcmp(scheduler->getName(), getSchedulerName(0)) != 0) {
+					printf("failed[default]\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#if !defined(NO_PRIORITY_TP_SUPPORT) && !defined(NO_DEADLINE_TP_SUPPORT)
+			const char *names[4] = {"prio", "fifo", "lifo", "edf"};
+			const int expected[4][4] = {{3, 1, 0, 2}, {0, 1, 2, 3}, {3, 2, 1, 0}, {2, 3, 1, 0}};
+			const uint8_t priority[4] = {10, 50, 0, 90};
+			const int deadline_ms[4] = {40, 30, 10, 20};
+
+			for (int sched = 0; sched < 4; sched++) {
+				std::shared_ptr<bool> running(new bool(true));
+				std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+				std::atomic<int> missed(0);
+				int slots[4] = {-1, -1, -1, -1};
+				Deadline_Functor *functors[4];
+
+				printf("%s:\t\t", names[sched]);
+				testpool.reset(new icke2063::threadpool::ThreadPool(1, true, NULL, createScheduler(names[sched])));
+				testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+				usleep(10000);
+
+				for (int i = 0; i < 4; i++) {
+					functors[i] = new Deadline_Functor(counter, &slots[i], &missed);
+					functors[i]->setPriority(priority[i]);
+					functors[i]->setDeadlineIn(std::chrono::milliseconds(deadline_ms[i]));
+					testpool->delegateFunctor(functors[i]);
+				}
+				if (testpool->getQueueCount() != 4 || testpool->getQueuePos(functors[expected[sched][0]]) != 0
+						|| testpool->getQueuePos(functors[expected[sched][3]]) != 3) {
+					printf("failed[pos]\n");
+					exit(1);
+				}
+
+				*running = false;
+				while (*counter < 4) {
+					usleep(1000);
+				}
+				for (int i = 0; i < 4; i++) {
+					if (slots[expected[sched][i]] != i) {
+						printf("failed[%d:%d]\n", i, slots[expected[sched][i]]);
+						exit(1);
+					}
+				}
+				testpool.reset();
+				printf("passed\n");
+			}
+#endif
+			printf("Test[c]: passed\n");
+		}
+		break;
+
+		case 'd':
+		{
+			/**
+			 * Test sharded functor queue (power of two choices, no pool lock)
+			 */
+
+			printf("Test d:\n");
+			printf("sharded scheduler test\n");
+
+			std::atomic<int> executed(0);
+
+			printf("balance:\t");
+			{
+				std::shared_ptr<bool> running(new bool(true));
+				ShardedScheduler *scheduler = new ShardedScheduler(4);
+
+				testpool.reset(new icke2063::threadpool::ThreadPool(2, true, NULL, scheduler));
+				testpool->delegateFunctor(new Endless_Functor(running));	// block workers
+				testpool->delegateFunctor(new Endless_Functor(running));
+				usleep(50000);
+
+				for (int i = 0; i < 400; i++) {
+					testpool->delegateFunctor(new Count_Functor(&executed));
+				}
+				if (testpool->getQueueCount() != 400) {
+					printf("failed[count %d]\n", (int)testpool->getQueueCount());
+					exit(1);
+				}
+				for (size_t i = 0; i < scheduler->getShardCount(); i++) {
+					if (scheduler->getShardSize(i) < 90 || scheduler->getShardSize(i) > 110) {
+						printf("failed[shard %u: %u]\n", (unsigned int)i, (unsigned int)scheduler->getShardSize(i));
+						exit(1);
+					}
+				}
+
+				*running = false;
+				for (int i = 0; i < 1000 && (executed < 400 || testpool->getQueueCount() != 0); i++) {
+					usleep(1000);
+				}
+				if (executed != 400 || testpool->getQueueCount() != 0) {
+					printf("failed[%d]\n", executed.load());
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("wakeup:\t\t");
+			executed = 0;
+			for (int i = 0; i < 2000; i++) {
+				// single functor to idle pool: lost wakeup would stall
+				testpool->delegateFunctor(new Count_Functor(&executed));
+				for (int wait = 0; wait < 1000 && executed <= i; wait++) {
+					usleep(100);
+				}
+				if (executed != i + 1) {
+					printf("failed[%d]\n", i);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#ifndef NO_DEADLINE_TP_SUPPORT
+			printf("pool queues:\t");
+			{
+				std::shared_ptr<bool> running(new bool(true));
+				std::shared_ptr<std::atomic<int> > counter(new std::atomic<int>(0));
+				std::vector<int> slots(100, -1);
+				int deadline_slot = -1;
+				std::atomic<int> missed(0);
+
+				testpool->delegateFunctor(new Endless_Functor(running));	// block workers
+				testpool->delegateFunctor(new Endless_Functor(running));
+				usleep(50000);
+				for (size_t i = 0; i < slots.size(); i++) {
+					testpool->delegateFunctor(new Seq_Functor(counter, &slots[i]));
+				}
+				Deadline_Functor *functor = new Deadline_Functor(counter, &deadline_slot, &missed);
+				functor->setDeadlineIn(std::chrono::seconds(10));
+				testpool->delegateDeadlineFunctor(functor);
+
+				*running = false;
+				for (int i = 0; i < 2000 && *counter < 101; i++) {
+					usleep(1000);
+				}
+				// deadline queue is not starved by busy shards
+				if (*counter != 101 || deadline_slot < 0 || deadline_slot > 4) {
+					printf("failed[%d]\n", deadline_slot);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+#endif
+
+			printf("producers:\t");
+			executed = 0;
+			{
+				std::vector<std::thread> producers;
+				for (int p = 0; p < 4; p++) {
+					producers.push_back(std::thread([&]() {
+						for (int i = 0; i < 500; i++) {
+							FunctorInt *functor = new Count_Functor(&executed);
+							if (testpool->delegateFunctorWait(functor, 1000) != NULL) {
+								delete functor;
+							}
+						}
+					}));
+				}
+				for (size_t p = 0; p < producers.size(); p++) {
+					producers[p].join();
+				}
+				testpool->shutdown(TP_SHUTDOWN_Drain);
+				if (executed != 2000 || testpool->getQueueCount() != 0) {
+					printf("failed[%d]\n", executed.load());
+					exit(1);
+				}
+			}
+			testpool.reset();
+			printf("passed\n");
+
+			printf("Test[d]: passed\n");
+		}
+		break;
+
+		case 'e':
+		{
+			/**
+			 * Test overload policy dropping queued internal functors (cancel on release)
+			 */
+
+			printf("Test e:\n");
+			printf("overload drop test\n");
+
+			std::shared_ptr<bool> running(new bool(true));
+			std::atomic<int> executed(0);
+			uint32_t dropped = 0;
+
+			TestPool *pool = new TestPool(1);
+			testpool.reset(pool);
+			testpool->setOverloadPolicy(TP_OVERLOAD_DropOldest);
+			testpool->delegateFunctor(new Endless_Functor(running));	// block single worker
+			usleep(10000);
+
+			// fill queue behind queued functor -> next one drops it, fillers are never handled
+			auto overflow = [&]() {
+				while (testpool->getQueueCount() < FUNCTOR_MAX) {
+					testpool->delegateFunctor(new Count_Functor(&executed));
+				}
+				if (testpool->delegateFunctor(new Count_Functor(&executed)) != NULL
+						|| testpool->getOverloadDropCount() != ++dropped) {
+					printf("failed[overflow]\n");
+					exit(1);
+				}
+				pool->clearQueue();
+			};
+			auto waitQueued = [&]() {
+				for (int i = 0; i < 1000 && testpool->getQueueCount() == 0; i++) {
+					usleep(1000);
+				}
+				return testpool->getQueueCount() == 1;
+			};
+
+			printf("graph:\t\t");
+			{
+				TaskGraph graph(testpool.get());
+				TaskGraph::node_id a = graph.addNode(new Count_Functor(&executed));
+				TaskGraph::node_id b = graph.addNode(new Count_Functor(&executed));
+				graph.addEdge(a, b);
+				if (!graph.submit() || !waitQueued()) {
+					printf("failed[submit]\n");
+					exit(1);
+				}
+				overflow();
+				if (!graph.wait(1000) || graph.getCancelledCount() != 2 || executed != 0) {
+					printf("failed\n");
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+			printf("strand:\t\t");
+			{
+				Strand strand(testpool.get());
+				for (int i = 0; i < 3; i++) {
+					strand.post(new Count_Functor(&executed));
+				}
+				if (!waitQueued()) {
+					printf("failed[post]\n");
+					exit(1);
+				}
+				overflow();
+				if (strand.getPendingCount() != 0 || executed != 0) {
+					printf("failed\n");
+					exit(1);
+				}
+			}	// destructor must not wait
+			printf("passed\n");
+
+			printf("parallel_for:\t");
+			{
+				std::atomic<long> sum(0);
+				std::atomic<bool> done(false);
+				std::thread caller([&]() {
+					parallel_for(testpool.get(), 0, 1000, 10, [&](size_t i) { sum += (long)i; });
+					done = true;
+				});
+				// drop each delegated range
+				for (int i = 0; i < 1000 && !done; i++) {
+					if (testpool->getQueueCount() > 0) {
+						overflow();
+					}
+					usleep(1000);
+				}
+				caller.join();
+				if (sum != 499500) {
+					printf("failed[%ld]\n", sum.load());
+					exit(1);
+				}
+			}
+			printf("passed\n");
+
+#ifdef TP_COROUTINE_SUPPORT
+			printf("coroutine:\t");
+			{
+				int result = 0;
+				std::thread caller([&]() {
+					try {
+						result = coro_square(testpool.get(), 7).get();
+					} catch (std::runtime_error &) {
+						result = -2;	// resumed as cancelled
+					}
+				});
+				if (!waitQueued()) {
+					printf("failed[schedule]\n");
+					exit(1);
+				}
+				overflow();
+				caller.join();
+				if (result != -2) {
+					printf("failed[%d]\n", result);
+					exit(1);
+				}
+			}
+			printf("passed\n");
+#endif
+
+#ifndef NO_REACTOR_TP_SUPPORT
+			printf("io handler:\t");
+			{
+				int socket_fds[2];
+				Read_IoFunctor handler;
+
+				if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, socket_fds) != 0
+						|| !testpool->registerFd(socket_fds[0], EPOLLIN, &handler)
+						|| write(socket_fds[1], "0123456789", 10) != 10 || !waitQueued()) {
+					printf("failed[register]\n");
+					exit(1);
+				}
+				overflow();
+				if (handler.isPending()) {
+					printf("failed[pending]\n");
+					exit(1);
+				}
+				// delegated again on next event
+				if (write(socket_fds[1], "0123456789", 10) != 10 || !waitQueued() || !handler.isPending()) {
+					printf("failed[again]\n");
+					exit(1);
+				}
+				testpool->unregisterFd(socket_fds[0]);
+				pool->clearQueue();
+				close(socket_fds[0]);
+				close(socket_fds[1]);
+			}
+			printf("passed\n");
+#endif
+
+#ifndef NO_DELAYED_TP_SUPPORT
+			printf("pool thread:\t");
+			{
+				std::atomic<int> delayed_runs(0);
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+
+				testpool->setOverloadPolicy(TP_OVERLOAD_CallerRuns);
+				while (testpool->getQueueCount() < FUNCTOR_MAX) {
+					testpool->delegateFunctor(new Count_Functor(&executed));
+				}
+				// due functor must not run within pool loop (locked delayed queue)
+				testpool->delegateDelayedFunctor(std::shared_ptr<DelayedFunctorInt>(
+						new DelayedFunctor(new Count_Functor(&delayed_runs), deadline)));
+				usleep(50000);
+				if (delayed_runs != 0) {
+					printf("failed\n");
+					exit(1);
+				}
+				pool->clearQueue();
+				if (!waitQueued()) {
+					printf("failed[retry]\n");
+					exit(1);
+				}
+				pool->clearQueue();
+			}
+			printf("passed\n");
+#endif
+
+			*running = false;
+			testpool.reset();
+			if (executed != 0) {
+				printf("failed[fillers %d]\n", executed.load());
+				exit(1);
+			}
+			printf("Test[e]: passed\n");
+		}
+		break;
+
 		default:
 			break;
 	}